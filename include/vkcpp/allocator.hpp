@@ -0,0 +1,128 @@
+#ifndef _VKCPP_ALLOCATOR_INCLUDED_
+#define _VKCPP_ALLOCATOR_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <mutex>
+
+namespace vkcpp
+{
+// Sub-allocates device memory out of large per memory type blocks using buddy bins. Buffers (and linear
+// images) and optimal images are kept in separate blocks, so bufferImageGranularity never has to be padded for.
+class allocator
+{
+public:
+    enum class resource_kind
+    {
+        LINEAR,
+        OPTIMAL
+    };
+
+    enum class create_flag
+    {
+        DEDICATED = 0x1
+    };
+    using create_flags = enum_flags< create_flag >;
+
+    static constexpr VkDeviceSize const min_allocation_size = 256;
+    static constexpr VkDeviceSize const max_block_size = VkDeviceSize( 256 ) << 20U;
+
+    struct statistics
+    {
+        size_t block_count{ 0 };
+        size_t dedicated_count{ 0 };
+        size_t allocation_count{ 0 };
+        VkDeviceSize reserved_bytes{ 0 };
+        VkDeviceSize used_bytes{ 0 };
+        VkDeviceSize requested_bytes{ 0 };
+        VkDeviceSize free_bytes{ 0 };
+        VkDeviceSize largest_free_range{ 0 };
+
+        // share of the free space that can not be handed out as one range, 0 when all free space is contiguous
+        [[nodiscard]] double fragmentation() const noexcept
+        {
+            return 0 < free_bytes ? 1.0 - static_cast< double >( largest_free_range ) / static_cast< double >( free_bytes ) : 0.0;
+        }
+    };
+
+    struct block;
+
+    class allocation
+    {
+    public:
+        allocation() = default;
+        allocation( allocation& ) = delete;
+        allocation& operator=( allocation& ) = delete;
+
+        allocation( allocation&& handle ) noexcept;
+        allocation& operator=( allocation&& handle ) noexcept;
+        ~allocation() noexcept { reset(); }
+
+        explicit operator bool() const noexcept { return nullptr != pblock_; }
+
+        void reset() noexcept;
+
+        [[nodiscard]] VkDeviceMemory native() const noexcept;
+        [[nodiscard]] VkDeviceSize offset() const noexcept { return offset_; }
+        [[nodiscard]] VkDeviceSize size() const noexcept { return size_; }
+        [[nodiscard]] unsigned memory_type_index() const noexcept;
+        [[nodiscard]] bool dedicated() const noexcept;
+
+        // the owning block stays mapped for its whole lifetime, so the pointer is valid until the allocation is reset
+        [[nodiscard]] void* map();
+
+    private:
+        friend class allocator;
+
+        allocation( allocator* pallocator, block* pblock, VkDeviceSize offset, VkDeviceSize size, unsigned order ) noexcept
+            : pallocator_( pallocator )
+            , pblock_( pblock )
+            , offset_( offset )
+            , size_( size )
+            , order_( order )
+        {}
+
+        allocator* pallocator_{ nullptr };
+        block* pblock_{ nullptr };
+        VkDeviceSize offset_{ 0 };
+        VkDeviceSize size_{ 0 };
+        unsigned order_{ 0 };
+    };
+
+    allocator( device const& device, physical_device physical_device, VkDeviceSize block_size = 0 );
+    allocator( allocator& ) = delete;
+    allocator& operator=( allocator& ) = delete;
+    ~allocator();
+
+    [[nodiscard]] allocation allocate( VkMemoryRequirements const& requirements, physical_device::memory_property::flags memory_flags,
+                                       resource_kind kind = resource_kind::LINEAR, create_flags flags = create_flags() );
+
+    [[nodiscard]] allocation allocate_dedicated( VkMemoryRequirements const& requirements, physical_device::memory_property::flags memory_flags,
+                                                 VkBuffer buffer, VkImage image = VK_NULL_HANDLE );
+
+    [[nodiscard]] statistics stats() const;
+    [[nodiscard]] statistics stats( unsigned memory_type_index ) const;
+
+    [[nodiscard]] physical_device::memory_property const& memory_property() const noexcept { return memory_property_; }
+
+private:
+    struct pool;
+
+    device_reference device_;
+    physical_device::memory_property memory_property_;
+    VkDeviceSize block_size_;
+    bool separate_kinds_;
+    mutable std::mutex mutex_;
+    std::vector< std::unique_ptr< pool > > pools_;
+
+    [[nodiscard]] unsigned select_memory_type( VkMemoryRequirements const& requirements, physical_device::memory_property::flags memory_flags ) const;
+    [[nodiscard]] pool& pool_of( unsigned memory_type_index, resource_kind kind );
+    [[nodiscard]] VkDeviceSize block_size_of( unsigned memory_type_index ) const noexcept;
+    allocation allocate_dedicated_impl( VkMemoryRequirements const& requirements, unsigned memory_type_index, void const* pnext );
+    void release( block* pblock, VkDeviceSize offset, VkDeviceSize size, unsigned order ) noexcept;
+    void* map( block* pblock );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_ALLOCATOR_INCLUDED_
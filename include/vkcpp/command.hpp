@@ -0,0 +1,94 @@
+#ifndef _VKCPP_COMMAND_INCLUDED_
+#define _VKCPP_COMMAND_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/scheduler.hpp>
+#include <vkcpp/sync.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace vkcpp
+{
+// Gives every recording thread a command pool of its own per frame in flight, so allocating and recording never take a
+// lock. A frame slot is reused only once the fence or timeline value it was ended with has completed, and its pools are
+// then reset in bulk with one vkResetCommandPool each; buffers are never freed one by one.
+class command_pool_manager
+{
+public:
+    command_pool_manager( device const& device, device::queue::family::id_type family_index, size_t frame_count = 2 );
+    command_pool_manager( command_pool_manager& ) = delete;
+    command_pool_manager& operator=( command_pool_manager& ) = delete;
+    // when a frame has not completed yet it waits for the whole device instead, its point may never have been
+    // submitted, so no other thread may be using a queue of the device by then
+    ~command_pool_manager();
+
+    // moves on to the next frame slot, waiting for what it was ended with and resetting its pools; no thread may be
+    // allocating from or recording into the manager while this runs
+    size_t begin_frame();
+
+    // the current slot may be reset once fence has signaled, or once timeline has reached value
+    void end_frame( VkFence fence );
+    void end_frame( VkSemaphore timeline, uint64_t value );
+
+    // a buffer from the calling thread's pool of the current frame, valid until that frame slot is reset; the pools of a
+    // thread are created on its first call and kept until the manager goes away, so record from long lived workers
+    [[nodiscard]] command_buffer allocate( command_buffer::level level = command_buffer::level::PRIMARY );
+
+    [[nodiscard]] size_t frame_index() const noexcept { return current_.load( std::memory_order_acquire ); }
+    [[nodiscard]] size_t frame_count() const noexcept { return guards_.size(); }
+    [[nodiscard]] size_t thread_count() const;
+
+private:
+    struct frame_pool
+    {
+        command_pool pool;
+        // recorded buffers stay allocated across resets and are handed out again from the front
+        std::array< std::vector< command_buffer >, 2 > buffers;
+        std::array< size_t, 2 > used{ 0, 0 };
+    };
+
+    struct thread_pools
+    {
+        std::vector< frame_pool > frames;
+    };
+
+    device_reference device_;
+    device::queue::family::id_type family_index_;
+    uint64_t id_;
+    // only ever held weakly by the threads' entries, which tell from it that the manager is gone
+    std::shared_ptr< void const > alive_;
+    std::atomic< size_t > current_;
+    // what each frame slot was ended with, empty for a slot not ended since it was last reset
+    std::vector< retirement_point > guards_;
+    mutable std::mutex mutex_;
+    std::vector< std::unique_ptr< thread_pools > > threads_;
+
+    [[nodiscard]] thread_pools& local();
+    void wait( retirement_point const& frame_guard ) const;
+};
+
+// Splits one recording job into chunks that are recorded into secondary buffers on the scheduler's threads, each thread
+// allocating from its own pools of the manager. The secondaries are executed into the primary buffer in chunk order,
+// so the result does not depend on which thread recorded what.
+class parallel_recorder
+{
+public:
+    using record_type = std::function< void( command_buffer const& secondary, size_t chunk ) >;
+
+    parallel_recorder( command_pool_manager& pools, task_scheduler& scheduler );
+
+    // inheritance is needed for chunks recorded inside a render pass, which also makes them render pass continuations
+    void record( command_buffer const& primary, size_t chunk_count, record_type const& record, VkCommandBufferInheritanceInfo const* inheritance = nullptr );
+
+private:
+    command_pool_manager& pools_;
+    task_scheduler& scheduler_;
+    std::vector< VkCommandBuffer > secondaries_;
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_COMMAND_INCLUDED_
@@ -0,0 +1,98 @@
+#ifndef _VKCPP_COROUTINE_INCLUDED_
+#define _VKCPP_COROUTINE_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+#include <thread>
+
+namespace vkcpp
+{
+// Completion reactor: one thread waits on every outstanding fence and timeline value and resumes the coroutine
+// awaiting it, so in-flight GPU jobs do not each hold a thread blocked in fence::wait.
+class reactor
+{
+public:
+    using executor_type = std::function< void( std::coroutine_handle<> ) >;
+
+    class awaiter
+    {
+    public:
+        [[nodiscard]] bool await_ready() noexcept;
+        bool await_suspend( std::coroutine_handle<> handle ) { return preactor_->watch( { fence_, semaphore_, value_, &status_, handle } ); }
+        void await_resume() const
+        {
+            if( VK_SUCCESS != status_ )
+            {
+                throw exception( status_, VK_NULL_HANDLE != fence_ ? dbg::object::FENCE : dbg::object::SEMAPHORE, "awaiting completion" );
+            }
+        }
+
+    private:
+        friend class reactor;
+
+        awaiter( reactor* const preactor, VkFence const fence, VkSemaphore const semaphore, uint64_t const value ) noexcept
+            : preactor_( preactor )
+            , fence_( fence )
+            , semaphore_( semaphore )
+            , value_( value )
+        {}
+
+        reactor* preactor_;
+        VkFence fence_;
+        VkSemaphore semaphore_;
+        uint64_t value_;
+        VkResult status_{ VK_NOT_READY };
+    };
+
+    // without an executor coroutines are resumed on the reactor thread itself
+    explicit reactor( device const& device, executor_type executor = executor_type(),
+                      std::chrono::nanoseconds poll_interval = std::chrono::milliseconds( 1 ) );
+    reactor( reactor& ) = delete;
+    reactor& operator=( reactor& ) = delete;
+    ~reactor();
+
+    [[nodiscard]] awaiter wait( VkFence const fence ) noexcept { return awaiter( this, fence, VK_NULL_HANDLE, 0 ); }
+    [[nodiscard]] awaiter wait( fence<> const& fence ) noexcept { return wait( fence.native() ); }
+
+    [[nodiscard]] awaiter wait( VkSemaphore const semaphore, uint64_t const value ) noexcept { return awaiter( this, VK_NULL_HANDLE, semaphore, value ); }
+    [[nodiscard]] awaiter wait( semaphore<> const& semaphore, uint64_t const value ) noexcept { return wait( semaphore.native(), value ); }
+
+    [[nodiscard]] size_t outstanding() const noexcept { return outstanding_.load( std::memory_order_relaxed ); }
+
+private:
+    struct watch_entry
+    {
+        VkFence fence;
+        VkSemaphore semaphore;
+        uint64_t value;
+        VkResult* pstatus;
+        std::coroutine_handle<> handle;
+    };
+
+    VkDevice device_;
+    private_::device_dispatch const* pdispatch_;
+    executor_type executor_;
+    std::chrono::nanoseconds poll_interval_;
+    std::mutex mutex_;
+    std::condition_variable_any condition_;
+    std::vector< watch_entry > incoming_;
+    // set once run() has handed back what was outstanding, later waits are not watched anymore
+    bool stopped_{ false };
+    std::atomic< size_t > outstanding_{ 0 };
+    std::jthread thread_;
+
+    [[nodiscard]] VkResult status_of( watch_entry const& entry ) const noexcept;
+    // false when the reactor has stopped, the entry then completes right away as not ready
+    [[nodiscard]] bool watch( watch_entry const& entry );
+    void resume( std::coroutine_handle<> handle );
+    void run( std::stop_token const& stop );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_COROUTINE_INCLUDED_
@@ -0,0 +1,81 @@
+#ifndef _VKCPP_DELETION_INCLUDED_
+#define _VKCPP_DELETION_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/sync.hpp>
+
+#include <deque>
+#include <mutex>
+
+namespace vkcpp
+{
+// Defers destroying objects the GPU may still be using. A retired handle is kept until the fence, or the timeline
+// semaphore value, it was retired with has been reached and is then destroyed together with everything else retired
+// before that point, so tearing resources down needs no device::wait_idle.
+class deletion_queue
+{
+public:
+    explicit deletion_queue( device const& device );
+    deletion_queue( deletion_queue& ) = delete;
+    deletion_queue& operator=( deletion_queue& ) = delete;
+    // destroys everything; when a retirement point has not passed yet it waits for the whole device instead of that
+    // point, which may never have been submitted, so no other thread may be using a queue of the device by then
+    ~deletion_queue();
+
+    // any movable owner works, a fence<>, a command_pool or an allocator::allocation alike
+    template< typename handle_type >
+        requires( !std::is_lvalue_reference_v< handle_type > )
+    void retire( handle_type&& handle, VkFence const fence )
+    {
+        retire_impl( retirement_point{ .fence = fence }, std::make_unique< retired< handle_type > >( std::forward< handle_type >( handle ) ) );
+    }
+
+    template< typename handle_type >
+        requires( !std::is_lvalue_reference_v< handle_type > )
+    void retire( handle_type&& handle, VkSemaphore const timeline, uint64_t const value )
+    {
+        retire_impl( retirement_point{ .timeline = timeline, .value = value },
+                     std::make_unique< retired< handle_type > >( std::forward< handle_type >( handle ) ) );
+    }
+
+    // destroys everything whose point the GPU has passed and returns how many objects went
+    size_t collect();
+
+    [[nodiscard]] size_t pending() const;
+
+private:
+    struct retired_base
+    {
+        retired_base() = default;
+        retired_base( retired_base& ) = delete;
+        retired_base& operator=( retired_base& ) = delete;
+        virtual ~retired_base() = default;
+    };
+
+    template< typename handle_type >
+    struct retired : retired_base
+    {
+        handle_type handle;
+
+        explicit retired( handle_type&& i_handle )
+            : handle( std::move( i_handle ) )
+        {}
+    };
+
+    struct batch
+    {
+        retirement_point at;
+        std::vector< std::unique_ptr< retired_base > > objects;
+    };
+
+    device_reference device_;
+    mutable std::mutex mutex_;
+    std::deque< batch > batches_;
+    size_t pending_count_{ 0 };
+
+    void retire_impl( retirement_point const& at, std::unique_ptr< retired_base > object );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_DELETION_INCLUDED_
@@ -0,0 +1,397 @@
+#ifndef _VKCPP_DESCRIPTOR_INCLUDED_
+#define _VKCPP_DESCRIPTOR_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/sync.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace vkcpp
+{
+// Hands out descriptor sets from chains of descriptor pools, one chain per allocating thread, and starts a new pool
+// whenever the current one is full. Sets are never freed one by one: retire() hands every pool in use to the GPU point
+// given and once that has passed the pools are reset in one call each and allocated from again.
+class descriptor_allocator
+{
+public:
+    // descriptors of each type one set needs on average, a pool for n sets holds n times these
+    static constexpr std::array< VkDescriptorPoolSize, 6 > const default_sizes{ VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
+                                                                                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 },
+                                                                                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 },
+                                                                                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1 },
+                                                                                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 },
+                                                                                VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLER, 1 } };
+
+    static constexpr uint32_t const max_sets_per_pool = 4096;
+
+    struct statistics
+    {
+        size_t pool_count{ 0 };
+        size_t active_pool_count{ 0 };
+        size_t retired_pool_count{ 0 };
+        size_t free_pool_count{ 0 };
+        size_t set_count{ 0 };
+        size_t reset_count{ 0 };
+    };
+
+    // each new pool holds twice as many sets as the one created before it, up to max_sets_per_pool
+    explicit descriptor_allocator( device const& device, std::span< VkDescriptorPoolSize const > sizes_per_set = default_sizes, uint32_t initial_sets = 64 );
+    descriptor_allocator( descriptor_allocator& ) = delete;
+    descriptor_allocator& operator=( descriptor_allocator& ) = delete;
+    // when a retirement point has not passed yet it waits for the whole device instead of that point, which may never
+    // have been submitted, so no other thread may be using a queue of the device by then; sets still in use that were
+    // never retired are the caller's business
+    ~descriptor_allocator();
+
+    [[nodiscard]] VkDescriptorSet allocate( VkDescriptorSetLayout layout, void const* pnext = nullptr );
+    // sets must have room for one set per layout, all of them come from the same pool
+    void allocate( std::span< VkDescriptorSetLayout const > layouts, VkDescriptorSet* sets, void const* pnext = nullptr );
+
+    // every set handed out so far, on any thread, is given back once the GPU passes the fence or timeline value
+    void retire( VkFence fence );
+    void retire( VkSemaphore timeline, uint64_t value );
+
+    // resets the pools whose point the GPU has passed and returns how many
+    size_t collect();
+
+    [[nodiscard]] statistics stats() const;
+
+private:
+    struct chain
+    {
+        std::mutex mutex;
+        std::vector< descriptor_pool > pools;
+        size_t set_count{ 0 };
+    };
+
+    struct batch
+    {
+        retirement_point at;
+        std::vector< descriptor_pool > pools;
+    };
+
+    device_reference device_;
+    std::vector< VkDescriptorPoolSize > sizes_per_set_;
+    uint64_t id_;
+    mutable std::mutex mutex_;
+    // retire() empties every chain and hands them out afresh, so there are never more of them than threads that
+    // allocated between two retirements, and an id an ended thread leaves behind is forgotten by the next one
+    std::vector< std::unique_ptr< chain > > chains_;
+    std::unordered_map< std::thread::id, chain* > assigned_;
+    // bumped by retire(), a thread's remembered chain is only good for the generation it was assigned in
+    std::atomic< uint64_t > generation_{ 0 };
+    std::deque< batch > batches_;
+    std::vector< descriptor_pool > free_;
+    uint32_t next_sets_;
+    size_t pool_count_{ 0 };
+    size_t reset_count_{ 0 };
+
+    [[nodiscard]] chain& chain_of_this_thread();
+    // created tells a new pool from a recycled one
+    [[nodiscard]] descriptor_pool acquire_pool( bool& created );
+    void retire_impl( retirement_point const& at );
+};
+
+namespace binding
+{
+// Descriptor data of one binding as an update template reads it, meant as a member of a struct describing a whole set
+template< uint32_t binding_index, VkDescriptorType descriptor_type, uint32_t descriptor_count = 1 >
+struct descriptor
+{
+    static constexpr bool const is_buffer = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER == descriptor_type || VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == descriptor_type ||
+                                            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == descriptor_type ||
+                                            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC == descriptor_type;
+    static constexpr bool const is_texel_buffer =
+        VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER == descriptor_type || VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER == descriptor_type;
+
+    using value_type = std::conditional_t< is_buffer, VkDescriptorBufferInfo, std::conditional_t< is_texel_buffer, VkBufferView, VkDescriptorImageInfo > >;
+
+    static constexpr uint32_t const index = binding_index;
+    static constexpr VkDescriptorType const type = descriptor_type;
+    static constexpr uint32_t const count = descriptor_count;
+
+    std::array< value_type, count > values{};
+
+    value_type& operator[]( size_t const ie ) noexcept { return values[ ie ]; }
+    value_type const& operator[]( size_t const ie ) const noexcept { return values[ ie ]; }
+
+    descriptor& operator=( value_type const& value ) noexcept
+        requires( 1 == count )
+    {
+        values[ 0 ] = value;
+        return *this;
+    }
+};
+
+template< uint32_t binding_index, uint32_t count = 1 >
+using uniform_buffer = descriptor< binding_index, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, count >;
+template< uint32_t binding_index, uint32_t count = 1 >
+using storage_buffer = descriptor< binding_index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, count >;
+template< uint32_t binding_index, uint32_t count = 1 >
+using combined_image_sampler = descriptor< binding_index, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, count >;
+template< uint32_t binding_index, uint32_t count = 1 >
+using sampled_image = descriptor< binding_index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, count >;
+template< uint32_t binding_index, uint32_t count = 1 >
+using storage_image = descriptor< binding_index, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, count >;
+
+} // namespace binding
+
+namespace private_
+{
+template< typename... field_types >
+struct type_list
+{
+    static constexpr size_t const size = sizeof...( field_types );
+};
+
+template< typename field_type >
+concept binding_field = requires {
+    typename field_type::value_type;
+    { field_type::index } -> std::convertible_to< uint32_t >;
+    { field_type::type } -> std::convertible_to< VkDescriptorType >;
+    { field_type::count } -> std::convertible_to< uint32_t >;
+};
+
+// converts to whatever member it initialises, so counting how many of these an aggregate takes counts its members
+struct any_field
+{
+    template< typename field_type >
+    operator field_type() const noexcept;
+};
+
+template< typename aggregate_type, typename... fields >
+consteval size_t field_count() noexcept
+{
+    if constexpr( requires { aggregate_type{ fields{}..., any_field{} }; } )
+    {
+        return field_count< aggregate_type, fields..., any_field >();
+    }
+    else
+    {
+        return sizeof...( fields );
+    }
+}
+
+template< typename... field_types >
+type_list< field_types... > type_list_of( field_types&... );
+
+// only ever named in decltype, the member types come out of a structured binding of the set struct
+template< typename set_type >
+auto field_types_of( set_type& value )
+{
+    constexpr auto const count = field_count< set_type >();
+    static_assert( 0 < count && count <= 16, "a descriptor set struct needs between 1 and 16 binding members" );
+    if constexpr( 1 == count )
+    {
+        auto& [ f0 ] = value;
+        return type_list_of( f0 );
+    }
+    else if constexpr( 2 == count )
+    {
+        auto& [ f0, f1 ] = value;
+        return type_list_of( f0, f1 );
+    }
+    else if constexpr( 3 == count )
+    {
+        auto& [ f0, f1, f2 ] = value;
+        return type_list_of( f0, f1, f2 );
+    }
+    else if constexpr( 4 == count )
+    {
+        auto& [ f0, f1, f2, f3 ] = value;
+        return type_list_of( f0, f1, f2, f3 );
+    }
+    else if constexpr( 5 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4 );
+    }
+    else if constexpr( 6 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5 );
+    }
+    else if constexpr( 7 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6 );
+    }
+    else if constexpr( 8 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7 );
+    }
+    else if constexpr( 9 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8 );
+    }
+    else if constexpr( 10 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9 );
+    }
+    else if constexpr( 11 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10 );
+    }
+    else if constexpr( 12 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11 );
+    }
+    else if constexpr( 13 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12 );
+    }
+    else if constexpr( 14 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13 );
+    }
+    else if constexpr( 15 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14 );
+    }
+    else if constexpr( 16 == count )
+    {
+        auto& [ f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15 ] = value;
+        return type_list_of( f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15 );
+    }
+}
+
+template< typename set_type >
+using set_fields = decltype( field_types_of( std::declval< set_type& >() ) );
+
+// members of a standard layout struct follow each other at their natural alignment, which is what lets the offsets
+// be worked out from the types alone; the size check in descriptor_set_template catches any struct where that fails
+template< typename... field_types >
+consteval std::array< VkDescriptorUpdateTemplateEntry, sizeof...( field_types ) > template_entries( type_list< field_types... > ) noexcept
+{
+    std::array< VkDescriptorUpdateTemplateEntry, sizeof...( field_types ) > result{};
+    size_t offset = 0;
+    size_t ie = 0;
+    auto const add = [ & ]< typename field_type >() {
+        offset = ( offset + alignof( field_type ) - 1 ) / alignof( field_type ) * alignof( field_type );
+        result[ ie++ ] = VkDescriptorUpdateTemplateEntry{ .dstBinding = field_type::index,
+                                                          .dstArrayElement = 0,
+                                                          .descriptorCount = field_type::count,
+                                                          .descriptorType = field_type::type,
+                                                          .offset = offset,
+                                                          .stride = sizeof( typename field_type::value_type ) };
+        offset += sizeof( field_type );
+    };
+    ( add.template operator()< field_types >(), ... );
+    return result;
+}
+
+template< typename... field_types >
+consteval size_t packed_size( type_list< field_types... > ) noexcept
+{
+    size_t offset = 0;
+    size_t alignment = 1;
+    ( ( offset = ( offset + alignof( field_types ) - 1 ) / alignof( field_types ) * alignof( field_types ) + sizeof( field_types ),
+        alignment = std::max( alignment, alignof( field_types ) ) ),
+      ... );
+    return ( offset + alignment - 1 ) / alignment * alignment;
+}
+
+template< typename... field_types >
+consteval bool all_bindings( type_list< field_types... > ) noexcept
+{
+    return ( binding_field< field_types > && ... );
+}
+
+} // namespace private_
+
+// Update template for a descriptor set described as a plain struct of binding:: members, for example
+//     struct blur_set { binding::storage_buffer< 0 > input; binding::storage_buffer< 1 > output; };
+// The template entries and the matching layout bindings are derived from the member types at compile time, so
+// filling in the struct and calling update() or push() replaces building VkWriteDescriptorSet arrays per dispatch.
+template< typename set_type >
+class descriptor_set_template
+{
+public:
+    using fields = private_::set_fields< set_type >;
+
+    static_assert( std::is_standard_layout_v< set_type > && std::is_trivially_copyable_v< set_type > );
+    static_assert( private_::all_bindings( fields() ), "every member of a descriptor set struct is a binding::descriptor" );
+    static_assert( sizeof( set_type ) == private_::packed_size( fields() ), "descriptor set struct members are not laid out back to back" );
+
+    static constexpr auto const entries = private_::template_entries( fields() );
+
+    // for creating the descriptor set layout the struct describes
+    [[nodiscard]] static constexpr std::array< VkDescriptorSetLayoutBinding, fields::size > layout_bindings( VkShaderStageFlags const stages ) noexcept
+    {
+        std::array< VkDescriptorSetLayoutBinding, fields::size > result{};
+        for( size_t ie = 0; ie < entries.size(); ++ie )
+        {
+            result[ ie ] = VkDescriptorSetLayoutBinding{ .binding = entries[ ie ].dstBinding,
+                                                         .descriptorType = entries[ ie ].descriptorType,
+                                                         .descriptorCount = entries[ ie ].descriptorCount,
+                                                         .stageFlags = stages,
+                                                         .pImmutableSamplers = nullptr };
+        }
+        return result;
+    }
+
+    descriptor_set_template() = default;
+
+    // updates sets allocated with layout
+    descriptor_set_template( device const& device, VkDescriptorSetLayout const layout )
+        : template_( device, create_info( VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET, layout, VK_PIPELINE_BIND_POINT_COMPUTE, VK_NULL_HANDLE, 0 ) )
+    {}
+
+    // pushes set number set of layout, the device needs device_extension::push_descriptor
+    descriptor_set_template( device const& device, VkPipelineBindPoint const bind_point, VkPipelineLayout const layout, uint32_t const set )
+        : template_( device, create_info( VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR, VK_NULL_HANDLE, bind_point, layout, set ) )
+        , layout_( layout )
+        , set_( set )
+    {}
+
+    [[nodiscard]] descriptor_update_template const& update_template() const noexcept { return template_; }
+
+    void update( VkDescriptorSet const set, set_type const& data ) const { template_.update( set, &data ); }
+
+    void push( command_buffer const& buffer, set_type const& data ) const
+    {
+        assert( VK_NULL_HANDLE != layout_ );
+        template_.push( buffer, layout_, set_, &data );
+    }
+
+private:
+    descriptor_update_template template_;
+    VkPipelineLayout layout_{ VK_NULL_HANDLE };
+    uint32_t set_{ 0 };
+
+    static VkDescriptorUpdateTemplateCreateInfo create_info( VkDescriptorUpdateTemplateType const type, VkDescriptorSetLayout const set_layout,
+                                                             VkPipelineBindPoint const bind_point, VkPipelineLayout const layout, uint32_t const set ) noexcept
+    {
+        return VkDescriptorUpdateTemplateCreateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+                                                     .pNext = nullptr,
+                                                     .flags = 0,
+                                                     .descriptorUpdateEntryCount = static_cast< uint32_t >( entries.size() ),
+                                                     .pDescriptorUpdateEntries = entries.data(),
+                                                     .templateType = type,
+                                                     .descriptorSetLayout = set_layout,
+                                                     .pipelineBindPoint = bind_point,
+                                                     .pipelineLayout = layout,
+                                                     .set = set };
+    }
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_DESCRIPTOR_INCLUDED_
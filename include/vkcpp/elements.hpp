@@ -4,19 +4,49 @@
 #include <vulkan/vulkan.h>
 
 #include <vector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <functional>
 #include <string_view>
+#include <span>
+#include <utility>
+#include <cstddef>
 #include <cassert>
 
 namespace vkcpp
 {
-enum class derived_handle_kind : bool
+// How many handles a derived handle owns: exactly one, a run time count kept on the heap, or up to a compile time
+// capacity kept inline, e.g. fence< derived_handle_kind::array< 3 > > for three frames in flight.
+struct derived_handle_kind
 {
-    unique,
-    vector
+    enum class storage : uint8_t
+    {
+        UNIQUE,
+        VECTOR,
+        ARRAY
+    };
+
+    storage storage_kind;
+    size_t capacity;
+
+    static derived_handle_kind const unique;
+    static derived_handle_kind const vector;
+    template< size_t array_capacity >
+    static derived_handle_kind const array;
+
+    [[nodiscard]] constexpr size_t default_size() const noexcept { return storage::ARRAY == storage_kind ? capacity : 1; }
+
+    friend constexpr bool operator==( derived_handle_kind const&, derived_handle_kind const& ) noexcept = default;
 };
 
+inline constexpr derived_handle_kind derived_handle_kind::unique{ storage::UNIQUE, 1 };
+inline constexpr derived_handle_kind derived_handle_kind::vector{ storage::VECTOR, 0 };
+template< size_t array_capacity >
+inline constexpr derived_handle_kind derived_handle_kind::array{ storage::ARRAY, array_capacity };
+
 namespace private_
 {
 template< typename vk_handle >
@@ -40,6 +70,7 @@ public:
 
     [[nodiscard]] native_type native() const noexcept { return native_; }
     [[nodiscard]] native_type* pnative() noexcept { return &native_; }
+    [[nodiscard]] native_type const* pnative() const noexcept { return &native_; }
 
 protected:
     explicit unique_handle( native_type const native ) noexcept
@@ -85,7 +116,7 @@ public:
     void reset( native_type const native = VK_NULL_HANDLE ) noexcept
     {
         assert( !( *this ) );
-        this->native_ = native;
+        *( this->pnative() ) = native;
     }
 
     [[nodiscard]] native_type replace( weak_handle&& handle ) noexcept
@@ -119,15 +150,136 @@ private:
     }
 };
 
+struct instance_dispatch
+{
+    PFN_vkDestroyInstance destroy_instance{ nullptr };
+    PFN_vkEnumeratePhysicalDevices enumerate_physical_devices{ nullptr };
+    PFN_vkGetPhysicalDeviceProperties get_physical_device_properties{ nullptr };
+    PFN_vkGetPhysicalDeviceFeatures get_physical_device_features{ nullptr };
+    PFN_vkGetPhysicalDeviceMemoryProperties get_physical_device_memory_properties{ nullptr };
+    PFN_vkGetPhysicalDeviceQueueFamilyProperties get_physical_device_queue_family_properties{ nullptr };
+    PFN_vkEnumerateDeviceExtensionProperties enumerate_device_extension_properties{ nullptr };
+    PFN_vkCreateDevice create_device{ nullptr };
+    PFN_vkGetDeviceProcAddr get_device_proc_addr{ nullptr };
+    PFN_vkCreateDebugReportCallbackEXT create_debug_report_callback{ nullptr };
+    PFN_vkDestroyDebugReportCallbackEXT destroy_debug_report_callback{ nullptr };
+    PFN_vkDebugReportMessageEXT debug_report_message{ nullptr };
+    // null where no device has VK_KHR_performance_query
+    PFN_vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR enumerate_queue_family_performance_query_counters{ nullptr };
+    PFN_vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR get_queue_family_performance_query_passes{ nullptr };
+    // null where no device has VK_EXT_calibrated_timestamps
+    PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT get_physical_device_calibrateable_time_domains{ nullptr };
+    // host allocation callbacks of the instance, passed to every create and destroy of it and its children
+    VkAllocationCallbacks const* allocation_callbacks{ nullptr };
+
+    instance_dispatch() = default;
+    instance_dispatch( VkInstance instance, VkAllocationCallbacks const* i_allocation_callbacks ) noexcept;
+};
+
+struct device_dispatch
+{
+    PFN_vkDestroyDevice destroy_device{ nullptr };
+    PFN_vkDeviceWaitIdle device_wait_idle{ nullptr };
+    PFN_vkGetDeviceQueue get_device_queue{ nullptr };
+    PFN_vkQueueWaitIdle queue_wait_idle{ nullptr };
+    PFN_vkQueueSubmit queue_submit{ nullptr };
+    PFN_vkCreateSemaphore create_semaphore{ nullptr };
+    PFN_vkDestroySemaphore destroy_semaphore{ nullptr };
+    PFN_vkGetSemaphoreCounterValue get_semaphore_counter_value{ nullptr };
+    PFN_vkWaitSemaphores wait_semaphores{ nullptr };
+    PFN_vkSignalSemaphore signal_semaphore{ nullptr };
+    PFN_vkCreateFence create_fence{ nullptr };
+    PFN_vkDestroyFence destroy_fence{ nullptr };
+    PFN_vkWaitForFences wait_for_fences{ nullptr };
+    PFN_vkResetFences reset_fences{ nullptr };
+    PFN_vkGetFenceStatus get_fence_status{ nullptr };
+    PFN_vkAllocateMemory allocate_memory{ nullptr };
+    PFN_vkFreeMemory free_memory{ nullptr };
+    PFN_vkMapMemory map_memory{ nullptr };
+    PFN_vkUnmapMemory unmap_memory{ nullptr };
+    PFN_vkCreateCommandPool create_command_pool{ nullptr };
+    PFN_vkDestroyCommandPool destroy_command_pool{ nullptr };
+    PFN_vkResetCommandPool reset_command_pool{ nullptr };
+    PFN_vkAllocateCommandBuffers allocate_command_buffers{ nullptr };
+    PFN_vkFreeCommandBuffers free_command_buffers{ nullptr };
+    PFN_vkBeginCommandBuffer begin_command_buffer{ nullptr };
+    PFN_vkEndCommandBuffer end_command_buffer{ nullptr };
+    PFN_vkResetCommandBuffer reset_command_buffer{ nullptr };
+    PFN_vkCmdExecuteCommands cmd_execute_commands{ nullptr };
+    PFN_vkCmdPipelineBarrier cmd_pipeline_barrier{ nullptr };
+    PFN_vkCreatePipelineCache create_pipeline_cache{ nullptr };
+    PFN_vkDestroyPipelineCache destroy_pipeline_cache{ nullptr };
+    PFN_vkGetPipelineCacheData get_pipeline_cache_data{ nullptr };
+    PFN_vkMergePipelineCaches merge_pipeline_caches{ nullptr };
+    PFN_vkCreateGraphicsPipelines create_graphics_pipelines{ nullptr };
+    PFN_vkCreateComputePipelines create_compute_pipelines{ nullptr };
+    PFN_vkDestroyPipeline destroy_pipeline{ nullptr };
+    PFN_vkCreateShaderModule create_shader_module{ nullptr };
+    PFN_vkDestroyShaderModule destroy_shader_module{ nullptr };
+    PFN_vkCreateDescriptorSetLayout create_descriptor_set_layout{ nullptr };
+    PFN_vkDestroyDescriptorSetLayout destroy_descriptor_set_layout{ nullptr };
+    PFN_vkCreatePipelineLayout create_pipeline_layout{ nullptr };
+    PFN_vkDestroyPipelineLayout destroy_pipeline_layout{ nullptr };
+    PFN_vkCreateSampler create_sampler{ nullptr };
+    PFN_vkDestroySampler destroy_sampler{ nullptr };
+    PFN_vkCreateDescriptorPool create_descriptor_pool{ nullptr };
+    PFN_vkDestroyDescriptorPool destroy_descriptor_pool{ nullptr };
+    PFN_vkResetDescriptorPool reset_descriptor_pool{ nullptr };
+    PFN_vkAllocateDescriptorSets allocate_descriptor_sets{ nullptr };
+    PFN_vkCreateDescriptorUpdateTemplate create_descriptor_update_template{ nullptr };
+    PFN_vkDestroyDescriptorUpdateTemplate destroy_descriptor_update_template{ nullptr };
+    PFN_vkUpdateDescriptorSetWithTemplate update_descriptor_set_with_template{ nullptr };
+    PFN_vkCreateQueryPool create_query_pool{ nullptr };
+    PFN_vkDestroyQueryPool destroy_query_pool{ nullptr };
+    PFN_vkGetQueryPoolResults get_query_pool_results{ nullptr };
+    PFN_vkCmdResetQueryPool cmd_reset_query_pool{ nullptr };
+    PFN_vkCmdWriteTimestamp cmd_write_timestamp{ nullptr };
+    PFN_vkCmdBeginQuery cmd_begin_query{ nullptr };
+    PFN_vkCmdEndQuery cmd_end_query{ nullptr };
+    // null unless the device was created with device_extension::performance_query
+    PFN_vkAcquireProfilingLockKHR acquire_profiling_lock{ nullptr };
+    PFN_vkReleaseProfilingLockKHR release_profiling_lock{ nullptr };
+    // null unless the device was created with device_extension::push_descriptor
+    PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set{ nullptr };
+    PFN_vkCmdPushDescriptorSetWithTemplateKHR cmd_push_descriptor_set_with_template{ nullptr };
+    // null unless the device was created with device_extension::calibrated_timestamps
+    PFN_vkGetCalibratedTimestampsEXT get_calibrated_timestamps{ nullptr };
+
+    // host allocation callbacks of the device, passed to every create and destroy of it and its children
+    VkAllocationCallbacks const* allocation_callbacks{ nullptr };
+
+    device_dispatch() = default;
+    device_dispatch( VkDevice device, PFN_vkGetDeviceProcAddr loader, VkAllocationCallbacks const* i_allocation_callbacks ) noexcept;
+};
+
 template< typename vk_handle >
-using vk_source_deleter = void( __stdcall* )( vk_handle, VkAllocationCallbacks const* );
+struct dispatch_of;
 
-template< typename vk_handle, vk_source_deleter< vk_handle > native_deleter >
+template<>
+struct dispatch_of< VkInstance >
+{
+    using type = instance_dispatch;
+};
+
+template<>
+struct dispatch_of< VkDevice >
+{
+    using type = device_dispatch;
+};
+
+template< typename vk_handle >
+using dispatch_type_t = typename dispatch_of< vk_handle >::type;
+
+template< typename vk_handle >
+using vk_source_deleter = void( VKAPI_PTR* )( vk_handle, VkAllocationCallbacks const* );
+
+template< typename vk_handle, vk_source_deleter< vk_handle > dispatch_type_t< vk_handle >::*native_deleter >
 class source_handle : public unique_handle< vk_handle >
 {
 public:
     using ancestor_type = source_handle;
     using deleter_type = vk_source_deleter< vk_handle >;
+    using dispatch_type = dispatch_type_t< vk_handle >;
     using base_type = unique_handle< vk_handle >;
     using native_type = typename base_type::native_type;
 
@@ -136,6 +288,7 @@ public:
 
     source_handle( source_handle&& handle ) noexcept
         : base_type( std::move( handle ) )
+        , dispatch_( std::move( handle.dispatch_ ) )
     {}
 
     source_handle& operator=( source_handle&& handle ) noexcept
@@ -147,20 +300,29 @@ public:
 
     void reset( source_handle&& handle ) noexcept
     {
-        if( this->native_ != handle.native_ )
+        if( this->native() != handle.native() )
         {
             free();
-            this->native_ = handle.native_;
-            handle.native_ = VK_NULL_HANDLE;
+            *( this->pnative() ) = handle.native();
+            *( handle.pnative() ) = VK_NULL_HANDLE;
+            dispatch_ = std::move( handle.dispatch_ );
         }
     }
 
     void reset() noexcept
     {
         free();
-        this->native_ = VK_NULL_HANDLE;
+        *( this->pnative() ) = VK_NULL_HANDLE;
+        dispatch_.reset();
     }
 
+    [[nodiscard]] dispatch_type const& dispatch() const noexcept
+    {
+        assert( dispatch_ );
+        return *dispatch_;
+    }
+    [[nodiscard]] dispatch_type const* pdispatch() const noexcept { return dispatch_.get(); }
+
 protected:
     source_handle() = default;
 
@@ -168,25 +330,32 @@ protected:
         : base_type( native )
     {}
 
+    void bind_dispatch( std::unique_ptr< dispatch_type const > dispatch ) noexcept { dispatch_ = std::move( dispatch ); }
+
     void free()
     {
         if( *this )
         {
-            native_deleter( this->native(), nullptr );
+            ( dispatch_.get()->*native_deleter )( this->native(), dispatch_->allocation_callbacks );
         }
     }
+
+private:
+    std::unique_ptr< dispatch_type const > dispatch_;
 };
 
 template< typename vk_source_handle, typename vk_derived_handle >
-using vk_derived_deleter = void( __stdcall* )( vk_source_handle, vk_derived_handle, VkAllocationCallbacks const* );
+using vk_derived_deleter = void( VKAPI_PTR* )( vk_source_handle, vk_derived_handle, VkAllocationCallbacks const* );
 
-template< typename vk_source_handle, typename vk_derived_handle, vk_derived_deleter< vk_source_handle, vk_derived_handle > native_deleter,
+template< typename vk_source_handle, typename vk_derived_handle,
+          vk_derived_deleter< vk_source_handle, vk_derived_handle > dispatch_type_t< vk_source_handle >::*native_deleter,
           derived_handle_kind handle_count = derived_handle_kind::unique >
 class derived_handle_base
 {
 public:
     using source_native_type = vk_source_handle;
     using native_type = vk_derived_handle;
+    using dispatch_type = dispatch_type_t< vk_source_handle >;
 
     derived_handle_base( derived_handle_base const& ) = delete;
     derived_handle_base& operator=( derived_handle_base& ) = delete;
@@ -202,29 +371,29 @@ protected:
 
     explicit operator bool() const { return ( bool )wnative_; }
 
-    bool free( source_native_type const source_native )
+    bool free( source_native_type const source_native, dispatch_type const* const pdispatch )
     {
         if( *this )
         {
-            native_deleter( source_native, wnative_.replace(), nullptr );
+            ( pdispatch->*native_deleter )( source_native, wnative_.replace(), pdispatch->allocation_callbacks );
             return true;
         }
         return false;
     }
 
-    void reset( source_native_type const source_native ) noexcept { free( source_native ); }
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept { free( source_native, pdispatch ); }
 
-    void reset( source_native_type const source_native, derived_handle_base&& handle )
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch, derived_handle_base&& handle )
     {
         if( wnative_.native() != handle.wnative_.native() )
         {
             if( *this )
             {
-                native_deleter( source_native, wnative_.replace( std::move( handle ) ), nullptr );
+                ( pdispatch->*native_deleter )( source_native, wnative_.replace( std::move( handle.wnative_ ) ), pdispatch->allocation_callbacks );
             }
             else
             {
-                wnative_.reset( std::move( handle ) );
+                wnative_.reset( std::move( handle.wnative_ ) );
             }
         }
     }
@@ -235,24 +404,28 @@ protected:
         return wnative_.pnative();
     }
 
-    native_type native( size_t const index = 0 )
+    native_type native( size_t const index = 0 ) const
     {
         assert( 0 == index );
         return wnative_.native();
     }
 
+    [[nodiscard]] std::span< native_type const > natives() const noexcept { return std::span< native_type const >( wnative_.pnative(), 1 ); }
+
     [[nodiscard]] size_t size() const { return 1; }
 
 private:
     weak_handle< native_type > wnative_;
 };
 
-template< typename vk_source_handle, typename vk_derived_handle, vk_derived_deleter< vk_source_handle, vk_derived_handle > native_deleter >
+template< typename vk_source_handle, typename vk_derived_handle,
+          vk_derived_deleter< vk_source_handle, vk_derived_handle > dispatch_type_t< vk_source_handle >::*native_deleter >
 class derived_handle_base< vk_source_handle, vk_derived_handle, native_deleter, derived_handle_kind::vector >
 {
 public:
     using source_native_type = vk_source_handle;
     using native_type = vk_derived_handle;
+    using dispatch_type = dispatch_type_t< vk_source_handle >;
 
     derived_handle_base( derived_handle_base const& ) = delete;
     derived_handle_base& operator=( derived_handle_base& ) = delete;
@@ -273,30 +446,30 @@ protected:
 
     explicit operator bool() const { return !wnative_vector_.empty() && wnative_vector_[ 0 ]; }
 
-    bool free( source_native_type const source_native ) noexcept
+    bool free( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept
     {
         if( *this )
         {
-            free_impl( source_native );
+            free_impl( source_native, pdispatch );
             return true;
         }
         return false;
     }
 
-    void reset( source_native_type const source_native ) noexcept
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept
     {
-        if( free( source_native ) )
+        if( free( source_native, pdispatch ) )
         {
             wnative_vector_.clear();
         }
     }
 
-    void reset( source_native_type const source_native, derived_handle_base&& handle ) noexcept
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch, derived_handle_base&& handle ) noexcept
     {
         if( this != &handle )
         {
-            free( source_native );
-            std::move( handle.wnative_vector_ );
+            free( source_native, pdispatch );
+            wnative_vector_ = std::move( handle.wnative_vector_ );
         }
     }
 
@@ -306,27 +479,117 @@ protected:
         return wnative_vector_[ index ].pnative();
     }
 
-    native_type native( size_t const index = 0 ) noexcept
+    native_type native( size_t const index = 0 ) const noexcept
     {
         assert( index < wnative_vector_.size() );
         return wnative_vector_[ index ].native();
     }
 
+    // weak_handle adds nothing to the native handle, so the vector doubles as an array of them
+    [[nodiscard]] std::span< native_type const > natives() const noexcept
+    {
+        static_assert( sizeof( weak_handle< native_type > ) == sizeof( native_type ) );
+        return wnative_vector_.empty() ? std::span< native_type const >() : std::span< native_type const >( wnative_vector_[ 0 ].pnative(), wnative_vector_.size() );
+    }
+
     [[nodiscard]] size_t size() const noexcept { return wnative_vector_.size(); }
 
 private:
     std::vector< weak_handle< native_type > > wnative_vector_;
 
-    void free_impl( source_native_type const source_native ) noexcept
+    void free_impl( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept
     {
         for( auto& in: wnative_vector_ )
         {
-            native_deleter( source_native, in.replace(), nullptr );
+            ( pdispatch->*native_deleter )( source_native, in.replace(), pdispatch->allocation_callbacks );
+        }
+    }
+};
+
+// Handles kept inline up to the capacity of the kind, so a group of them costs no allocation and hands its natives
+// straight to the API
+template< typename vk_source_handle, typename vk_derived_handle,
+          vk_derived_deleter< vk_source_handle, vk_derived_handle > dispatch_type_t< vk_source_handle >::*native_deleter, derived_handle_kind handle_count >
+    requires( derived_handle_kind::storage::ARRAY == handle_count.storage_kind )
+class derived_handle_base< vk_source_handle, vk_derived_handle, native_deleter, handle_count >
+{
+public:
+    using source_native_type = vk_source_handle;
+    using native_type = vk_derived_handle;
+    using dispatch_type = dispatch_type_t< vk_source_handle >;
+
+    static constexpr size_t const capacity = handle_count.capacity;
+
+    derived_handle_base( derived_handle_base const& ) = delete;
+    derived_handle_base& operator=( derived_handle_base& ) = delete;
+
+protected:
+    explicit derived_handle_base( size_t const size = capacity )
+        : size_( size )
+    {
+        assert( 0 < size && size <= capacity );
+    }
+
+    derived_handle_base( derived_handle_base&& handle ) noexcept
+        : natives_( handle.natives_ )
+        , size_( handle.size_ )
+    {
+        handle.natives_.fill( VK_NULL_HANDLE );
+    }
+
+    ~derived_handle_base() = default;
+
+    explicit operator bool() const { return VK_NULL_HANDLE != natives_[ 0 ]; }
+
+    bool free( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept
+    {
+        if( *this )
+        {
+            for( size_t in = 0; in < size_; ++in )
+            {
+                ( pdispatch->*native_deleter )( source_native, std::exchange( natives_[ in ], VK_NULL_HANDLE ), pdispatch->allocation_callbacks );
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch ) noexcept { free( source_native, pdispatch ); }
+
+    void reset( source_native_type const source_native, dispatch_type const* const pdispatch, derived_handle_base&& handle ) noexcept
+    {
+        if( this != &handle )
+        {
+            free( source_native, pdispatch );
+            natives_ = handle.natives_;
+            size_ = handle.size_;
+            handle.natives_.fill( VK_NULL_HANDLE );
         }
     }
+
+    native_type* pnative( size_t const index = 0 ) noexcept
+    {
+        assert( index < size_ );
+        return &natives_[ index ];
+    }
+
+    native_type native( size_t const index = 0 ) const noexcept
+    {
+        assert( index < size_ );
+        return natives_[ index ];
+    }
+
+    [[nodiscard]] std::span< native_type const > natives() const noexcept { return std::span< native_type const >( natives_.data(), size_ ); }
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+private:
+    std::array< native_type, capacity > natives_{};
+    size_t size_;
 };
 
-template< typename vk_source_handle, typename vk_derived_handle, vk_derived_deleter< vk_source_handle, vk_derived_handle > native_deleter,
+template< typename vk_source_handle, typename vk_derived_handle,
+          vk_derived_deleter< vk_source_handle, vk_derived_handle > dispatch_type_t< vk_source_handle >::*native_deleter,
           derived_handle_kind handle_count = derived_handle_kind::unique >
 class derived_handle : public derived_handle_base< vk_source_handle, vk_derived_handle, native_deleter, handle_count >
 {
@@ -334,53 +597,71 @@ public:
     using base_type = derived_handle_base< vk_source_handle, vk_derived_handle, native_deleter, handle_count >;
     using source_native_type = typename base_type::source_native_type;
     using native_type = typename base_type::native_type;
+    using dispatch_type = typename base_type::dispatch_type;
 
     derived_handle( derived_handle&& handle ) noexcept
         : base_type( std::move( handle ) )
         , source_native_( handle.source_native_ )
+        , pdispatch_( handle.pdispatch_ )
     {
         handle.source_native_ = VK_NULL_HANDLE;
+        handle.pdispatch_ = nullptr;
     }
     derived_handle( derived_handle& ) = delete;
     derived_handle& operator=( derived_handle& ) = delete;
 
-    derived_handle& operator=( derived_handle&& handle ) noexcept { reset( source_native_, std::move( handle ) ); }
+    derived_handle& operator=( derived_handle&& handle ) noexcept
+    {
+        reset( std::move( handle ) );
+        return *this;
+    }
 
-    ~derived_handle() { base_type::free( source_native_ ); }
+    ~derived_handle() { base_type::free( source_native_, pdispatch_ ); }
 
     explicit operator bool() const { return source_native_ != VK_NULL_HANDLE && base_type::operator bool(); }
 
     void reset() noexcept
     {
-        base_type::reset( source_native_ );
+        base_type::reset( source_native_, pdispatch_ );
         source_native_ = VK_NULL_HANDLE;
+        pdispatch_ = nullptr;
     }
 
     void reset( derived_handle&& handle ) noexcept
     {
         if( this != &handle )
         {
+            base_type::reset( source_native_, pdispatch_, std::move( handle ) );
             source_native_ = handle.source_native_;
-            base_type::reset( std::move( handle ) );
+            pdispatch_ = handle.pdispatch_;
             handle.source_native_ = VK_NULL_HANDLE;
+            handle.pdispatch_ = nullptr;
         }
     }
 
     [[nodiscard]] native_type native( size_t const index = 0 ) const noexcept { return base_type::native( index ); }
+    // contiguous natives of every handle, ready for VkSubmitInfo or vkWaitForFences
+    [[nodiscard]] std::span< native_type const > natives() const noexcept { return base_type::natives(); }
     [[nodiscard]] source_native_type source_native() const noexcept { return source_native_; }
 
+    [[nodiscard]] dispatch_type const& dispatch() const noexcept
+    {
+        assert( nullptr != pdispatch_ );
+        return *pdispatch_;
+    }
+
 protected:
-    explicit derived_handle( size_t const size, source_native_type const source_native = VK_NULL_HANDLE )
+    explicit derived_handle( size_t const size, source_native_type const source_native = VK_NULL_HANDLE, dispatch_type const* const pdispatch = nullptr )
         : base_type( size )
         , source_native_( source_native )
+        , pdispatch_( pdispatch )
     {}
 
 private:
     source_native_type source_native_;
+    dispatch_type const* pdispatch_;
 };
 
-void __stdcall destroy_debug_report( VkInstance, VkDebugReportCallbackEXT, VkAllocationCallbacks const* );
-
 } // namespace private_
 
 class version
@@ -507,6 +788,8 @@ enum class result
     ERROR_INCOMPATIBLE_DRIVER = VK_ERROR_INCOMPATIBLE_DRIVER,
     ERROR_TOO_MANY_OBJECTS = VK_ERROR_TOO_MANY_OBJECTS,
     ERROR_FORMAT_NOT_SUPPORTED = VK_ERROR_FORMAT_NOT_SUPPORTED,
+    ERROR_FRAGMENTED_POOL = VK_ERROR_FRAGMENTED_POOL,
+    ERROR_OUT_OF_POOL_MEMORY = VK_ERROR_OUT_OF_POOL_MEMORY,
     ERROR_SURFACE_LOST_KHR = VK_ERROR_SURFACE_LOST_KHR,
     ERROR_NATIVE_WINDOW_IN_USE_KHR = VK_ERROR_NATIVE_WINDOW_IN_USE_KHR,
     SUBOPTIMAL_KHR = VK_SUBOPTIMAL_KHR,
@@ -590,6 +873,242 @@ struct exception : public std::runtime_error
     {}
 };
 
+// What a non-throwing call failed with, raise() turns it into the exception the throwing call would have thrown
+struct error
+{
+    enum result result;
+    dbg::object object;
+    char const* description;
+
+    [[noreturn]] void raise() const { throw exception( result, object, description ); }
+};
+
+// Value or error of a non-throwing call, in the manner of std::expected. Non-success statuses that are normal
+// results, like TIMEOUT or NOT_READY for a polling wait, come back as errors without any unwinding, while value()
+// throws so the throwing API stays a thin layer over the try_ calls.
+template< typename value_type = void >
+class expected
+{
+public:
+    expected( value_type value ) noexcept( std::is_nothrow_move_constructible_v< value_type > )
+        : value_( std::move( value ) )
+    {}
+
+    expected( error const failure ) noexcept
+        : failure_( failure )
+    {
+        assert( result::SUCCESS != failure.result );
+    }
+
+    explicit operator bool() const noexcept { return value_.has_value(); }
+    [[nodiscard]] bool has_value() const noexcept { return value_.has_value(); }
+    [[nodiscard]] result status() const noexcept { return failure_.result; }
+    [[nodiscard]] error const& failure() const noexcept { return failure_; }
+
+    value_type& value() &
+    {
+        raise_if_failed();
+        return *value_;
+    }
+
+    value_type const& value() const&
+    {
+        raise_if_failed();
+        return *value_;
+    }
+
+    value_type&& value() &&
+    {
+        raise_if_failed();
+        return std::move( *value_ );
+    }
+
+    template< typename other_type >
+    [[nodiscard]] value_type value_or( other_type&& other ) const&
+    {
+        return value_.has_value() ? *value_ : static_cast< value_type >( std::forward< other_type >( other ) );
+    }
+
+    value_type& operator*() & noexcept
+    {
+        assert( value_.has_value() );
+        return *value_;
+    }
+
+    value_type const& operator*() const& noexcept
+    {
+        assert( value_.has_value() );
+        return *value_;
+    }
+
+private:
+    std::optional< value_type > value_;
+    error failure_{ result::SUCCESS, dbg::object::UNKNOWN, nullptr };
+
+    void raise_if_failed() const
+    {
+        if( !value_.has_value() )
+        {
+            failure_.raise();
+        }
+    }
+};
+
+template<>
+class expected< void >
+{
+public:
+    expected() noexcept = default;
+
+    expected( error const failure ) noexcept
+        : failure_( failure )
+    {
+        assert( result::SUCCESS != failure.result );
+    }
+
+    explicit operator bool() const noexcept { return result::SUCCESS == failure_.result; }
+    [[nodiscard]] bool has_value() const noexcept { return result::SUCCESS == failure_.result; }
+    [[nodiscard]] result status() const noexcept { return failure_.result; }
+    [[nodiscard]] error const& failure() const noexcept { return failure_; }
+
+    void value() const
+    {
+        if( !has_value() )
+        {
+            failure_.raise();
+        }
+    }
+
+private:
+    error failure_{ result::SUCCESS, dbg::object::UNKNOWN, nullptr };
+};
+
+// The wrapper entry points counted and timed when the library is built with the VKCPP_INSTRUMENT_CALLS option, one
+// for each Vulkan command they make; see vkcpp/instrument.hpp for reading the counts
+enum class api_call
+{
+    ENUMERATE_INSTANCE_LAYER_PROPERTIES,
+    ENUMERATE_INSTANCE_EXTENSION_PROPERTIES,
+    CREATE_INSTANCE,
+    CREATE_DEBUG_REPORT_CALLBACK,
+    ENUMERATE_PHYSICAL_DEVICES,
+    ENUMERATE_DEVICE_EXTENSION_PROPERTIES,
+    GET_PHYSICAL_DEVICE_QUEUE_FAMILY_PROPERTIES,
+    CREATE_DEVICE,
+    GET_DEVICE_QUEUE,
+    QUEUE_SUBMIT,
+    QUEUE_WAIT_IDLE,
+    DEVICE_WAIT_IDLE,
+    ALLOCATE_MEMORY,
+    MAP_MEMORY,
+    UNMAP_MEMORY,
+    BEGIN_COMMAND_BUFFER,
+    END_COMMAND_BUFFER,
+    RESET_COMMAND_BUFFER,
+    CREATE_COMMAND_POOL,
+    ALLOCATE_COMMAND_BUFFERS,
+    FREE_COMMAND_BUFFERS,
+    RESET_COMMAND_POOL,
+    CREATE_PIPELINE_CACHE,
+    GET_PIPELINE_CACHE_DATA,
+    MERGE_PIPELINE_CACHES,
+    CREATE_COMPUTE_PIPELINES,
+    CREATE_GRAPHICS_PIPELINES,
+    CREATE_SHADER_MODULE,
+    CREATE_DESCRIPTOR_SET_LAYOUT,
+    CREATE_PIPELINE_LAYOUT,
+    CREATE_SAMPLER,
+    CREATE_DESCRIPTOR_POOL,
+    ALLOCATE_DESCRIPTOR_SETS,
+    RESET_DESCRIPTOR_POOL,
+    CREATE_QUERY_POOL,
+    GET_QUERY_POOL_RESULTS,
+    CREATE_DESCRIPTOR_UPDATE_TEMPLATE,
+    CREATE_FENCE,
+    WAIT_FOR_FENCES,
+    GET_FENCE_STATUS,
+    RESET_FENCES,
+    CREATE_SEMAPHORE,
+    GET_SEMAPHORE_COUNTER_VALUE,
+    SIGNAL_SEMAPHORE,
+    WAIT_SEMAPHORES,
+    MAX_CALL
+};
+
+namespace private_
+{
+inline expected<> check( VkResult const status, dbg::object const object, char const* const description ) noexcept
+{
+    if( VK_SUCCESS == status )
+    {
+        return {};
+    }
+    return error{ static_cast< result >( status ), object, description };
+}
+
+// Set while a trace_recorder records, a trace scope then logs the span of the wrapped call on the calling thread's
+// event buffer. Otherwise it costs a relaxed load.
+inline std::atomic< bool > tracing{ false };
+
+[[nodiscard]] int64_t trace_clock() noexcept;
+void trace_event( char const* name, int64_t begin, int64_t end ) noexcept;
+
+class trace_scope
+{
+public:
+    explicit trace_scope( char const* const name ) noexcept
+        : name_( tracing.load( std::memory_order_relaxed ) ? name : nullptr )
+        , begin_( nullptr != name_ ? trace_clock() : 0 )
+    {}
+    trace_scope( trace_scope& ) = delete;
+    trace_scope& operator=( trace_scope& ) = delete;
+
+    ~trace_scope()
+    {
+        if( nullptr != name_ )
+        {
+            trace_event( name_, begin_, trace_clock() );
+        }
+    }
+
+private:
+    char const* name_;
+    int64_t begin_;
+};
+
+void record_call( api_call call, int64_t nanoseconds ) noexcept;
+
+// Counts and times one wrapper call on the calling thread's counters. Without VKCPP_INSTRUMENT_CALLS it is an empty
+// object the compiler drops entirely.
+#ifdef VKCPP_INSTRUMENT_CALLS
+class call_scope
+{
+public:
+    explicit call_scope( api_call const call ) noexcept
+        : call_( call )
+        , begin_( trace_clock() )
+    {}
+    call_scope( call_scope& ) = delete;
+    call_scope& operator=( call_scope& ) = delete;
+
+    ~call_scope() { record_call( call_, trace_clock() - begin_ ); }
+
+private:
+    api_call call_;
+    int64_t begin_;
+};
+#else
+class call_scope
+{
+public:
+    explicit constexpr call_scope( api_call ) noexcept {}
+    call_scope( call_scope& ) = delete;
+    call_scope& operator=( call_scope& ) = delete;
+};
+#endif
+
+} // namespace private_
+
 using offset2d = VkOffset2D;
 using offset3d = VkOffset3D;
 using extent2d = VkExtent2D;
@@ -627,10 +1146,10 @@ struct extension : public VkExtensionProperties
     [[nodiscard]] version spec_version() const { return version( specVersion ); }
 };
 
-class instance : public private_::source_handle< VkInstance, vkDestroyInstance >
+class instance : public private_::source_handle< VkInstance, &private_::instance_dispatch::destroy_instance >
 {
 public:
-    using base_type = private_::source_handle< VkInstance, vkDestroyInstance >;
+    using base_type = private_::source_handle< VkInstance, &private_::instance_dispatch::destroy_instance >;
 
     using base_type::base_type;
 
@@ -638,8 +1157,10 @@ public:
         : base_type( std::move( base ) )
     {}
 
+    // allocation_callbacks, when given, must outlive the instance and every device created from it without callbacks of its own
     instance( std::string const& app_name, version app_version, std::string const& engine_name, version engine_version,
-              std::vector< layer::id_type > const& layers, std::vector< extension::id_type > const& extensions );
+              std::vector< layer::id_type > const& layers, std::vector< extension::id_type > const& extensions,
+              VkAllocationCallbacks const* allocation_callbacks = nullptr );
 
 private:
     std::vector< layer::id_type > layer_list_;
@@ -651,16 +1172,18 @@ namespace dbg
 using callback_type = std::function< bool( flag flag, object const, unsigned long long const object_id, int const location, int const message_code,
                                            std::string_view layer_prefix, std::string_view message, void* puserdata ) >;
 
-struct report : public private_::derived_handle< VkInstance, VkDebugReportCallbackEXT, private_::destroy_debug_report, derived_handle_kind::unique >
+struct report
+    : public private_::derived_handle< VkInstance, VkDebugReportCallbackEXT, &private_::instance_dispatch::destroy_debug_report_callback, derived_handle_kind::unique >
 {
 private:
     callback_type mc_report_;
     void* puser_data_;
 
 public:
-    using base_type = private_::derived_handle< VkInstance, VkDebugReportCallbackEXT, private_::destroy_debug_report, derived_handle_kind::unique >;
+    using base_type =
+        private_::derived_handle< VkInstance, VkDebugReportCallbackEXT, &private_::instance_dispatch::destroy_debug_report_callback, derived_handle_kind::unique >;
 
-    report( vkcpp::instance instance, callback_type cb, flags flags, void* puser );
+    report( vkcpp::instance const& instance, callback_type cb, flags flags, void* puser );
 
     bool operator()( flags flags, object object, int message_code, std::string const& message );
     bool operator()( flag flag, object object, unsigned long long object_id, int location, int message_code, std::string_view layer_prefix,
@@ -673,6 +1196,7 @@ class physical_device
 {
 private:
     VkPhysicalDevice native_{ VK_NULL_HANDLE };
+    private_::instance_dispatch const* pdispatch_{ nullptr };
 
 public:
     enum class kind
@@ -689,14 +1213,25 @@ public:
 
     physical_device() = default;
 
+    physical_device( VkPhysicalDevice const native, private_::instance_dispatch const* const pdispatch ) noexcept
+        : native_( native )
+        , pdispatch_( pdispatch )
+    {}
+
     [[nodiscard]] VkPhysicalDevice native() const noexcept { return native_; }
 
+    [[nodiscard]] private_::instance_dispatch const& dispatch() const noexcept
+    {
+        assert( nullptr != pdispatch_ );
+        return *pdispatch_;
+    }
+
     struct property : public VkPhysicalDeviceProperties
     {
         explicit property( physical_device const i_physical_device )
             : VkPhysicalDeviceProperties{}
         {
-            vkGetPhysicalDeviceProperties( i_physical_device.native(), this );
+            i_physical_device.dispatch().get_physical_device_properties( i_physical_device.native(), this );
         }
 
         [[nodiscard]] version api_version() const noexcept { return version( apiVersion ); }
@@ -714,7 +1249,7 @@ public:
         explicit feature( physical_device const physical_device )
             : VkPhysicalDeviceFeatures{}
         {
-            vkGetPhysicalDeviceFeatures( physical_device.native(), this );
+            physical_device.dispatch().get_physical_device_features( physical_device.native(), this );
         }
     };
 
@@ -734,7 +1269,7 @@ public:
         explicit memory_property( physical_device const physical_device )
             : VkPhysicalDeviceMemoryProperties{}
         {
-            vkGetPhysicalDeviceMemoryProperties( physical_device.native(), this );
+            physical_device.dispatch().get_physical_device_memory_properties( physical_device.native(), this );
         }
 
         [[nodiscard]] unsigned find_memory_type_index( unsigned memory_type_index_bits, flags memory_type_flags ) const noexcept;
@@ -745,13 +1280,16 @@ class device_extension : public extension
 {
 public:
     static constexpr id_type const swap_chain = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    static constexpr id_type const push_descriptor = VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME;
+    static constexpr id_type const performance_query = VK_KHR_PERFORMANCE_QUERY_EXTENSION_NAME;
+    static constexpr id_type const calibrated_timestamps = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
     static std::vector< extension > enumerate( physical_device device, layer::id_type layer_id );
 };
 
-class device : public private_::source_handle< VkDevice, vkDestroyDevice >
+class device : public private_::source_handle< VkDevice, &private_::device_dispatch::destroy_device >
 {
 public:
-    using base_type = private_::source_handle< VkDevice, vkDestroyDevice >;
+    using base_type = private_::source_handle< VkDevice, &private_::device_dispatch::destroy_device >;
 
     device() = default;
 
@@ -759,7 +1297,8 @@ public:
         : base_type( std::move( i_handle ) )
     {}
 
-    void wait_idle() const;
+    void wait_idle() const { try_wait_idle().value(); }
+    [[nodiscard]] expected<> try_wait_idle() const noexcept;
 
     class queue
     {
@@ -803,16 +1342,55 @@ public:
         using id_type = uint32_t;
         using priority_type = float;
 
+        // Places every kind on the most specialised family that supports it, so transfers land on DMA only families and
+        // compute on async compute families when the device has them. Kinds sharing a family get queues of their own
+        // as long as the family has enough of them. Presentation needs a surface and is left unplaced.
+        class topology
+        {
+        public:
+            struct location
+            {
+                family::id_type family_index{ family::IGNORE_FAMILY };
+                id_type index{ 0 };
+            };
+
+            topology() = default;
+            explicit topology( physical_device physical_device );
+
+            [[nodiscard]] location const& operator[]( kind const queue_kind ) const noexcept { return locations_[ queue_kind ]; }
+            [[nodiscard]] bool has( kind const queue_kind ) const noexcept { return family::IGNORE_FAMILY != locations_[ queue_kind ].family_index; }
+            // true when the kind runs on another family than graphics, i.e. it overlaps with graphics work
+            [[nodiscard]] bool dedicated( kind queue_kind ) const noexcept;
+
+            // number of queues to reserve per family index
+            [[nodiscard]] std::vector< uint32_t > const& queue_counts() const noexcept { return queue_counts_; }
+
+        private:
+            std::array< location, MAX_KIND > locations_;
+            std::vector< uint32_t > queue_counts_;
+        };
+
         queue() = default;
 
-        queue( device device, family::id_type family_index, id_type index );
+        queue( device const& device, family::id_type family_index, id_type index );
 
         [[nodiscard]] VkQueue native() const { return native_; }
 
-        void wait_idle() const;
+        [[nodiscard]] private_::device_dispatch const& dispatch() const noexcept
+        {
+            assert( nullptr != pdispatch_ );
+            return *pdispatch_;
+        }
+
+        void submit( std::span< VkSubmitInfo const > infos, VkFence fence = VK_NULL_HANDLE ) const { try_submit( infos, fence ).value(); }
+        void wait_idle() const { try_wait_idle().value(); }
+
+        [[nodiscard]] expected<> try_submit( std::span< VkSubmitInfo const > infos, VkFence fence = VK_NULL_HANDLE ) const noexcept;
+        [[nodiscard]] expected<> try_wait_idle() const noexcept;
 
     private:
         VkQueue native_{ VK_NULL_HANDLE };
+        private_::device_dispatch const* pdispatch_{ nullptr };
     };
 
     class builder : public base_type
@@ -820,10 +1398,34 @@ public:
     private:
         std::vector< VkDeviceQueueCreateInfo > reserved_queues_;
         std::vector< std::vector< queue::priority_type > > queue_priorities_;
+        VkPhysicalDeviceVulkan12Features features12_{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_12_FEATURES };
+        VkAllocationCallbacks const* allocation_callbacks_{ nullptr };
+        bool use_instance_callbacks_{ true };
 
     public:
         builder() = default;
 
+        builder& enable_timeline_semaphore() &
+        {
+            features12_.timelineSemaphore = VK_TRUE;
+            return *this;
+        }
+
+        builder&& enable_timeline_semaphore() && { return std::move( enable_timeline_semaphore() ); }
+
+        // without callbacks of its own the device uses those of its instance
+        builder& use_allocation_callbacks( VkAllocationCallbacks const* const allocation_callbacks ) &
+        {
+            allocation_callbacks_ = allocation_callbacks;
+            use_instance_callbacks_ = false;
+            return *this;
+        }
+
+        builder&& use_allocation_callbacks( VkAllocationCallbacks const* const allocation_callbacks ) &&
+        {
+            return std::move( use_allocation_callbacks( allocation_callbacks ) );
+        }
+
         builder& reserve_queue_family( queue::family::id_type family_index, std::vector< queue::priority_type > queue_priority ) &;
 
         builder&& reserve_queue_family( queue::family::id_type family_index, std::vector< queue::priority_type > queue_priority ) &&
@@ -831,24 +1433,109 @@ public:
             return std::move( reserve_queue_family( family_index, std::move( queue_priority ) ) );
         }
 
+        builder& reserve_queues( queue::topology const& topology ) &;
+
+        builder&& reserve_queues( queue::topology const& topology ) && { return std::move( reserve_queues( topology ) ); }
+
+        // without any reserved family the queues of queue::topology( physical_device ) are reserved
         device build( physical_device physical_device, physical_device::feature const& feature, std::vector< layer::id_type > const& layers,
                       std::vector< device_extension::id_type > const& extensions );
     };
+
+    // The queues a topology placed, fetched from a device built with its families reserved
+    class queue_set
+    {
+    public:
+        queue_set() = default;
+        queue_set( device const& device, queue::topology const& topology );
+
+        [[nodiscard]] queue const& operator[]( queue::kind const queue_kind ) const noexcept { return queues_[ queue_kind ]; }
+        [[nodiscard]] queue const& graphics() const noexcept { return queues_[ queue::GRAPHICS ]; }
+        [[nodiscard]] queue const& computation() const noexcept { return queues_[ queue::COMPUTATION ]; }
+        [[nodiscard]] queue const& transfer() const noexcept { return queues_[ queue::TRANSFER ]; }
+        [[nodiscard]] queue const& sparse_binding() const noexcept { return queues_[ queue::SPARSE_BINDING ]; }
+
+        [[nodiscard]] queue::family::id_type family_index( queue::kind const queue_kind ) const noexcept { return topology_[ queue_kind ].family_index; }
+        [[nodiscard]] queue::topology const& topology() const noexcept { return topology_; }
+
+    private:
+        queue::topology topology_;
+        std::array< queue, queue::MAX_KIND > queues_;
+    };
+};
+
+// What an object made on a device keeps of it: the handle and the dispatch table, neither of which changes when the
+// device object is moved, unlike the address of the device. Made implicitly from a device, so whatever takes one
+// takes a device as well.
+class device_reference
+{
+public:
+    device_reference() = default;
+    device_reference( device const& device ) noexcept
+        : native_( device.native() )
+        , pdispatch_( device.pdispatch() )
+    {}
+
+    explicit operator bool() const noexcept { return VK_NULL_HANDLE != native_; }
+
+    [[nodiscard]] VkDevice native() const noexcept { return native_; }
+    [[nodiscard]] private_::device_dispatch const& dispatch() const noexcept
+    {
+        assert( nullptr != pdispatch_ );
+        return *pdispatch_;
+    }
+    [[nodiscard]] private_::device_dispatch const* pdispatch() const noexcept { return pdispatch_; }
+
+private:
+    VkDevice native_{ VK_NULL_HANDLE };
+    private_::device_dispatch const* pdispatch_{ nullptr };
 };
 
 template< derived_handle_kind handle_kind = derived_handle_kind::unique >
-class semaphore : public private_::derived_handle< VkDevice, VkSemaphore, vkDestroySemaphore, handle_kind >
+class semaphore : public private_::derived_handle< VkDevice, VkSemaphore, &private_::device_dispatch::destroy_semaphore, handle_kind >
 {
 public:
-    using base_type = private_::derived_handle< VkDevice, VkSemaphore, vkDestroySemaphore, handle_kind >;
-    explicit semaphore( device device = vkcpp::device(), size_t size = 1 );
+    using base_type = private_::derived_handle< VkDevice, VkSemaphore, &private_::device_dispatch::destroy_semaphore, handle_kind >;
+    using value_type = uint64_t;
+
+    enum class kind
+    {
+        BINARY = VK_SEMAPHORE_TYPE_BINARY,
+        TIMELINE = VK_SEMAPHORE_TYPE_TIMELINE
+    };
+
+    explicit semaphore( device const& device = vkcpp::device(), size_t size = handle_kind.default_size(), kind semaphore_kind = kind::BINARY,
+                        value_type initial_value = 0 );
+
+    [[nodiscard]] kind semaphore_kind() const noexcept { return kind_; }
+
+    // host side access to timeline semaphores, the device needs builder::enable_timeline_semaphore
+    [[nodiscard]] value_type value( size_t index = 0 ) const { return try_value( index ).value(); }
+    void signal( value_type value, size_t index = 0 ) { try_signal( value, index ).value(); }
+
+    void wait( value_type value, unsigned long long timeout ) { try_wait( value, timeout ).value(); }
+    void wait_all( std::span< value_type const > values, unsigned long long timeout ) { try_wait_all( values, timeout ).value(); }
+    void wait_any( std::span< value_type const > values, unsigned long long timeout ) { try_wait_any( values, timeout ).value(); }
+
+    // non-throwing forms, a wait that runs out of time fails with result::TIMEOUT; try_wait on a heap group of more
+    // than 64 semaphores fails with result::ERROR_OUT_OF_HOST_MEMORY, try_wait_all takes those
+    [[nodiscard]] expected< value_type > try_value( size_t index = 0 ) const noexcept;
+    [[nodiscard]] expected<> try_signal( value_type value, size_t index = 0 ) noexcept;
+    [[nodiscard]] expected<> try_wait( value_type value, unsigned long long timeout ) noexcept;
+    [[nodiscard]] expected<> try_wait_all( std::span< value_type const > values, unsigned long long timeout ) noexcept;
+    [[nodiscard]] expected<> try_wait_any( std::span< value_type const > values, unsigned long long timeout ) noexcept;
+
+private:
+    kind kind_;
+
+    expected<> wait_impl( std::span< value_type const > values, VkSemaphoreWaitFlags flags, unsigned long long timeout ) noexcept;
 };
 
 template< derived_handle_kind handle_kind = derived_handle_kind::unique >
-class fence : public private_::derived_handle< VkDevice, VkFence, vkDestroyFence, handle_kind >
+class fence : public private_::derived_handle< VkDevice, VkFence, &private_::device_dispatch::destroy_fence, handle_kind >
 {
 public:
-    using base_type = private_::derived_handle< VkDevice, VkFence, vkDestroyFence, handle_kind >;
+    using base_type = private_::derived_handle< VkDevice, VkFence, &private_::device_dispatch::destroy_fence, handle_kind >;
 
     enum class create_flag
     {
@@ -856,15 +1543,506 @@ public:
     };
     using create_flags = enum_flags< create_flag >;
 
-    explicit fence( device device = vkcpp::device(), size_t size = 1, create_flags flags = create_flags() );
+    explicit fence( device const& device = vkcpp::device(), size_t size = handle_kind.default_size(), create_flags flags = create_flags() );
 
-    void wait( unsigned long long timeout );
-    void reset_signal();
+    void wait( unsigned long long timeout ) { try_wait( timeout ).value(); }
+    // waits until at least one fence is signaled and returns the index of the first signaled one
+    [[nodiscard]] size_t wait_any( unsigned long long timeout ) { return try_wait_any( timeout ).value(); }
+    [[nodiscard]] bool signaled( size_t index = 0 ) const { return try_signaled( index ).value(); }
+    void reset_signal() { try_reset_signal().value(); }
+
+    // non-throwing forms for polling loops, a wait that runs out of time fails with result::TIMEOUT
+    [[nodiscard]] expected<> try_wait( unsigned long long timeout ) noexcept;
+    [[nodiscard]] expected< size_t > try_wait_any( unsigned long long timeout ) noexcept;
+    [[nodiscard]] expected< bool > try_signaled( size_t index = 0 ) const noexcept;
+    [[nodiscard]] expected<> try_reset_signal() noexcept;
 
 protected:
     using base_type::base_type;
 };
 
+template< derived_handle_kind handle_kind >
+semaphore< handle_kind >::semaphore( device const& device, size_t const size, kind const semaphore_kind, value_type const initial_value )
+    : base_type( size, device.native(), device.pdispatch() )
+    , kind_( semaphore_kind )
+{
+    if( device )
+    {
+        VkSemaphoreTypeCreateInfo type_info{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+                                             .pNext = nullptr,
+                                             .semaphoreType = static_cast< VkSemaphoreType >( semaphore_kind ),
+                                             .initialValue = initial_value };
+        VkSemaphoreCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        info.flags = 0;
+        info.pNext = kind::TIMELINE == semaphore_kind ? &type_info : nullptr;
+        for( size_t is = 0; is < size; ++is )
+        {
+            private_::call_scope const call( api_call::CREATE_SEMAPHORE );
+            auto status = device.dispatch().create_semaphore( device.native(), &info, device.dispatch().allocation_callbacks, base_type::pnative( is ) );
+            if( VK_SUCCESS != status )
+            {
+                throw exception( status, dbg::object::SEMAPHORE, "creation" );
+            }
+        }
+    }
+}
+
+template< derived_handle_kind handle_kind >
+expected< typename semaphore< handle_kind >::value_type > semaphore< handle_kind >::try_value( size_t const index ) const noexcept
+{
+    assert( *this && kind::TIMELINE == kind_ );
+    value_type result = 0;
+    private_::call_scope const call( api_call::GET_SEMAPHORE_COUNTER_VALUE );
+    auto status = this->dispatch().get_semaphore_counter_value( this->source_native(), this->native( index ), &result );
+    if( VK_SUCCESS == status )
+    {
+        return result;
+    }
+    return error{ static_cast< vkcpp::result >( status ), dbg::object::SEMAPHORE, "value query" };
+}
+
+template< derived_handle_kind handle_kind >
+expected<> semaphore< handle_kind >::try_signal( value_type const value, size_t const index ) noexcept
+{
+    assert( *this && kind::TIMELINE == kind_ );
+    private_::call_scope const call( api_call::SIGNAL_SEMAPHORE );
+    private_::trace_scope const scope( "vkSignalSemaphore" );
+    VkSemaphoreSignalInfo info{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO, .pNext = nullptr, .semaphore = this->native( index ), .value = value };
+    return private_::check( this->dispatch().signal_semaphore( this->source_native(), &info ), dbg::object::SEMAPHORE, "signal" );
+}
+
+template< derived_handle_kind handle_kind >
+expected<> semaphore< handle_kind >::try_wait( value_type const value, unsigned long long const timeout ) noexcept
+{
+    if( 1 == base_type::size() )
+    {
+        return wait_impl( std::span< value_type const >( &value, 1 ), 0, timeout );
+    }
+    else if constexpr( derived_handle_kind::storage::ARRAY == handle_kind.storage_kind )
+    {
+        std::array< value_type, handle_kind.capacity > values;
+        values.fill( value );
+        return wait_impl( std::span< value_type const >( values.data(), base_type::size() ), 0, timeout );
+    }
+    else
+    {
+        // no allocation in a noexcept wait, larger heap groups pass their values to try_wait_all
+        constexpr size_t const max_size = 64;
+        if( max_size < base_type::size() )
+        {
+            return error{ result::ERROR_OUT_OF_HOST_MEMORY, dbg::object::SEMAPHORE, "waiting on a large group" };
+        }
+        std::array< value_type, max_size > values;
+        values.fill( value );
+        return wait_impl( std::span< value_type const >( values.data(), base_type::size() ), 0, timeout );
+    }
+}
+
+template< derived_handle_kind handle_kind >
+expected<> semaphore< handle_kind >::try_wait_all( std::span< value_type const > const values, unsigned long long const timeout ) noexcept
+{
+    return wait_impl( values, 0, timeout );
+}
+
+template< derived_handle_kind handle_kind >
+expected<> semaphore< handle_kind >::try_wait_any( std::span< value_type const > const values, unsigned long long const timeout ) noexcept
+{
+    return wait_impl( values, VK_SEMAPHORE_WAIT_ANY_BIT, timeout );
+}
+
+template< derived_handle_kind handle_kind >
+expected<> semaphore< handle_kind >::wait_impl( std::span< value_type const > const values, VkSemaphoreWaitFlags const flags,
+                                               unsigned long long const timeout ) noexcept
+{
+    assert( *this && kind::TIMELINE == kind_ );
+    assert( values.size() == base_type::size() );
+    private_::call_scope const call( api_call::WAIT_SEMAPHORES );
+    private_::trace_scope const scope( "vkWaitSemaphores" );
+    VkSemaphoreWaitInfo info{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                              .pNext = nullptr,
+                              .flags = flags,
+                              .semaphoreCount = static_cast< uint32_t >( base_type::size() ),
+                              .pSemaphores = this->natives().data(),
+                              .pValues = values.data() };
+    return private_::check( this->dispatch().wait_semaphores( this->source_native(), &info, timeout ), dbg::object::SEMAPHORE, "waiting" );
+}
+
+template< derived_handle_kind handle_kind >
+fence< handle_kind >::fence( device const& device, size_t const size, create_flags const flags )
+    : base_type( size, device.native(), device.pdispatch() )
+{
+    if( device )
+    {
+        VkFenceCreateInfo info{};
+
+        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        info.pNext = nullptr;
+        info.flags = flags();
+        for( size_t iif = 0; iif < size; ++iif )
+        {
+            private_::call_scope const call( api_call::CREATE_FENCE );
+            auto status = device.dispatch().create_fence( device.native(), &info, device.dispatch().allocation_callbacks, base_type::pnative( iif ) );
+            if( VK_SUCCESS != status )
+            {
+                throw vkcpp::exception( status, vkcpp::dbg::object::FENCE, "creation" );
+            }
+        }
+    }
+}
+
+template< derived_handle_kind handle_kind >
+expected<> fence< handle_kind >::try_wait( unsigned long long const timeout ) noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::WAIT_FOR_FENCES );
+    private_::trace_scope const scope( "vkWaitForFences" );
+    auto status = this->dispatch().wait_for_fences( this->source_native(), static_cast< uint32_t >( base_type::size() ), this->natives().data(), VK_TRUE, timeout );
+    return private_::check( status, dbg::object::FENCE, "waiting" );
+}
+
+template< derived_handle_kind handle_kind >
+expected< size_t > fence< handle_kind >::try_wait_any( unsigned long long const timeout ) noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::WAIT_FOR_FENCES );
+    private_::trace_scope const scope( "vkWaitForFences" );
+    auto status = this->dispatch().wait_for_fences( this->source_native(), static_cast< uint32_t >( base_type::size() ), this->natives().data(), VK_FALSE, timeout );
+    if( VK_SUCCESS == status )
+    {
+        for( size_t iif = 0; iif < base_type::size(); ++iif )
+        {
+            auto const fence_signaled = try_signaled( iif );
+            if( !fence_signaled || *fence_signaled )
+            {
+                return fence_signaled ? expected< size_t >( iif ) : expected< size_t >( fence_signaled.failure() );
+            }
+        }
+        // a fence reset by another thread in between, reported as a wait that ran out of time
+        status = VK_TIMEOUT;
+    }
+    return error{ static_cast< result >( status ), dbg::object::FENCE, "waiting for any" };
+}
+
+template< derived_handle_kind handle_kind >
+expected< bool > fence< handle_kind >::try_signaled( size_t const index ) const noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::GET_FENCE_STATUS );
+    auto status = this->dispatch().get_fence_status( this->source_native(), this->native( index ) );
+    if( VK_SUCCESS == status || VK_NOT_READY == status )
+    {
+        return VK_SUCCESS == status;
+    }
+    return error{ static_cast< result >( status ), dbg::object::FENCE, "status query" };
+}
+
+template< derived_handle_kind handle_kind >
+expected<> fence< handle_kind >::try_reset_signal() noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::RESET_FENCES );
+    auto status = this->dispatch().reset_fences( this->source_native(), static_cast< uint32_t >( base_type::size() ), this->natives().data() );
+    return private_::check( status, dbg::object::FENCE, "reset" );
+}
+
+class device_memory : public private_::derived_handle< VkDevice, VkDeviceMemory, &private_::device_dispatch::free_memory >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkDeviceMemory, &private_::device_dispatch::free_memory >;
+
+    device_memory()
+        : base_type( 1 )
+    {}
+
+    device_memory( device_reference device, VkDeviceSize size, unsigned memory_type_index, void const* pnext = nullptr );
+
+    [[nodiscard]] VkDeviceSize size() const noexcept { return size_; }
+    [[nodiscard]] unsigned memory_type_index() const noexcept { return memory_type_index_; }
+
+    [[nodiscard]] void* map( VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE );
+    void unmap() noexcept;
+
+private:
+    VkDeviceSize size_{ 0 };
+    unsigned memory_type_index_{ 0 };
+};
+
+// Command buffers belong to their pool and go away with it, so like device::queue this only refers to one
+class command_buffer
+{
+public:
+    enum class level
+    {
+        PRIMARY = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        SECONDARY = VK_COMMAND_BUFFER_LEVEL_SECONDARY
+    };
+
+    enum class usage_flag
+    {
+        ONE_TIME_SUBMIT = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        RENDER_PASS_CONTINUE = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        SIMULTANEOUS_USE = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+    };
+    using usage_flags = enum_flags< usage_flag >;
+
+    command_buffer() = default;
+
+    command_buffer( VkCommandBuffer const native, private_::device_dispatch const* const pdispatch ) noexcept
+        : native_( native )
+        , pdispatch_( pdispatch )
+    {}
+
+    explicit operator bool() const noexcept { return VK_NULL_HANDLE != native_; }
+
+    [[nodiscard]] VkCommandBuffer native() const noexcept { return native_; }
+
+    [[nodiscard]] private_::device_dispatch const& dispatch() const noexcept
+    {
+        assert( nullptr != pdispatch_ );
+        return *pdispatch_;
+    }
+
+    void begin( usage_flags flags = usage_flags( usage_flag::ONE_TIME_SUBMIT ), VkCommandBufferInheritanceInfo const* inheritance = nullptr ) const
+    {
+        try_begin( flags, inheritance ).value();
+    }
+    void end() const { try_end().value(); }
+    // only for buffers of a pool created with command_pool::create_flag::RESET_COMMAND_BUFFER
+    void reset( bool release_resources = false ) const { try_reset( release_resources ).value(); }
+
+    [[nodiscard]] expected<> try_begin( usage_flags flags = usage_flags( usage_flag::ONE_TIME_SUBMIT ),
+                                        VkCommandBufferInheritanceInfo const* inheritance = nullptr ) const noexcept;
+    [[nodiscard]] expected<> try_end() const noexcept;
+    [[nodiscard]] expected<> try_reset( bool release_resources = false ) const noexcept;
+
+    // records the secondaries into this primary buffer in the order given
+    void execute( std::span< VkCommandBuffer const > secondaries ) const
+    {
+        dispatch().cmd_execute_commands( native_, static_cast< uint32_t >( secondaries.size() ), secondaries.data() );
+    }
+
+    // queries have to be reset before they are written again, outside of any render pass
+    void reset_queries( VkQueryPool const pool, uint32_t const first, uint32_t const count ) const
+    {
+        dispatch().cmd_reset_query_pool( native_, pool, first, count );
+    }
+
+    void write_timestamp( VkPipelineStageFlagBits const stage, VkQueryPool const pool, uint32_t const query ) const
+    {
+        dispatch().cmd_write_timestamp( native_, stage, pool, query );
+    }
+
+    // at most one query of each type may be active in a buffer at a time
+    void begin_query( VkQueryPool const pool, uint32_t const query, VkQueryControlFlags const flags = 0 ) const
+    {
+        dispatch().cmd_begin_query( native_, pool, query, flags );
+    }
+
+    void end_query( VkQueryPool const pool, uint32_t const query ) const { dispatch().cmd_end_query( native_, pool, query ); }
+
+    // writes set number set of layout straight into the buffer, no descriptor set needed; the device needs
+    // device_extension::push_descriptor and the writes leave dstSet empty
+    void push_descriptor_set( VkPipelineBindPoint const bind_point, VkPipelineLayout const layout, uint32_t const set,
+                              std::span< VkWriteDescriptorSet const > const writes ) const
+    {
+        assert( nullptr != dispatch().cmd_push_descriptor_set );
+        dispatch().cmd_push_descriptor_set( native_, bind_point, layout, set, static_cast< uint32_t >( writes.size() ), writes.data() );
+    }
+
+private:
+    VkCommandBuffer native_{ VK_NULL_HANDLE };
+    private_::device_dispatch const* pdispatch_{ nullptr };
+};
+
+class command_pool : public private_::derived_handle< VkDevice, VkCommandPool, &private_::device_dispatch::destroy_command_pool >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkCommandPool, &private_::device_dispatch::destroy_command_pool >;
+
+    enum class create_flag
+    {
+        TRANSIENT = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        RESET_COMMAND_BUFFER = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+    };
+    using create_flags = enum_flags< create_flag >;
+
+    command_pool()
+        : base_type( 1 )
+    {}
+
+    command_pool( device_reference device, device::queue::family::id_type family_index, create_flags flags = create_flags() );
+
+    [[nodiscard]] device::queue::family::id_type family_index() const noexcept { return family_index_; }
+
+    [[nodiscard]] std::vector< command_buffer > allocate( uint32_t count, command_buffer::level level = command_buffer::level::PRIMARY ) const;
+    void free_buffers( std::span< command_buffer const > buffers ) const;
+
+    // returns every buffer of the pool to the initial state in one call
+    void reset_buffers( bool release_resources = false ) const { try_reset_buffers( release_resources ).value(); }
+    [[nodiscard]] expected<> try_reset_buffers( bool release_resources = false ) const noexcept;
+
+private:
+    device::queue::family::id_type family_index_{ device::queue::family::IGNORE_FAMILY };
+};
+
+class pipeline_cache : public private_::derived_handle< VkDevice, VkPipelineCache, &private_::device_dispatch::destroy_pipeline_cache >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkPipelineCache, &private_::device_dispatch::destroy_pipeline_cache >;
+
+    pipeline_cache()
+        : base_type( 1 )
+    {}
+
+    // the driver ignores initial data it does not recognise and starts out empty instead
+    explicit pipeline_cache( device_reference device, std::span< std::byte const > initial_data = {} );
+
+    [[nodiscard]] std::vector< std::byte > data() const;
+
+    // folds the content of the sources into this cache, which must not be in use by another merge meanwhile
+    void merge( std::span< VkPipelineCache const > sources ) const;
+};
+
+class pipeline : public private_::derived_handle< VkDevice, VkPipeline, &private_::device_dispatch::destroy_pipeline >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkPipeline, &private_::device_dispatch::destroy_pipeline >;
+
+    pipeline()
+        : base_type( 1 )
+    {}
+
+    pipeline( device_reference device, VkComputePipelineCreateInfo const& info, VkPipelineCache cache = VK_NULL_HANDLE );
+    pipeline( device_reference device, VkGraphicsPipelineCreateInfo const& info, VkPipelineCache cache = VK_NULL_HANDLE );
+};
+
+class shader_module : public private_::derived_handle< VkDevice, VkShaderModule, &private_::device_dispatch::destroy_shader_module >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkShaderModule, &private_::device_dispatch::destroy_shader_module >;
+
+    shader_module()
+        : base_type( 1 )
+    {}
+
+    shader_module( device_reference device, VkShaderModuleCreateInfo const& info );
+    // SPIR-V words, as compiled
+    shader_module( device_reference device, std::span< uint32_t const > code );
+};
+
+class descriptor_set_layout : public private_::derived_handle< VkDevice, VkDescriptorSetLayout, &private_::device_dispatch::destroy_descriptor_set_layout >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkDescriptorSetLayout, &private_::device_dispatch::destroy_descriptor_set_layout >;
+
+    descriptor_set_layout()
+        : base_type( 1 )
+    {}
+
+    descriptor_set_layout( device_reference device, VkDescriptorSetLayoutCreateInfo const& info );
+};
+
+class pipeline_layout : public private_::derived_handle< VkDevice, VkPipelineLayout, &private_::device_dispatch::destroy_pipeline_layout >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkPipelineLayout, &private_::device_dispatch::destroy_pipeline_layout >;
+
+    pipeline_layout()
+        : base_type( 1 )
+    {}
+
+    pipeline_layout( device_reference device, VkPipelineLayoutCreateInfo const& info );
+};
+
+class sampler : public private_::derived_handle< VkDevice, VkSampler, &private_::device_dispatch::destroy_sampler >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkSampler, &private_::device_dispatch::destroy_sampler >;
+
+    sampler()
+        : base_type( 1 )
+    {}
+
+    sampler( device_reference device, VkSamplerCreateInfo const& info );
+};
+
+// Sets are not freed one by one, they all go back at once with reset(), so pools are never created with
+// VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT here
+class descriptor_pool : public private_::derived_handle< VkDevice, VkDescriptorPool, &private_::device_dispatch::destroy_descriptor_pool >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkDescriptorPool, &private_::device_dispatch::destroy_descriptor_pool >;
+
+    descriptor_pool()
+        : base_type( 1 )
+    {}
+
+    descriptor_pool( device_reference device, VkDescriptorPoolCreateInfo const& info );
+    descriptor_pool( device_reference device, uint32_t max_sets, std::span< VkDescriptorPoolSize const > sizes );
+
+    // one set for each layout, in the same order
+    [[nodiscard]] std::vector< VkDescriptorSet > allocate( std::span< VkDescriptorSetLayout const > layouts, void const* pnext = nullptr ) const;
+    // sets must have room for one set per layout; VK_ERROR_OUT_OF_POOL_MEMORY and VK_ERROR_FRAGMENTED_POOL only mean the pool is full
+    [[nodiscard]] expected<> try_allocate( std::span< VkDescriptorSetLayout const > layouts, VkDescriptorSet* sets, void const* pnext = nullptr ) const noexcept;
+
+    // returns every set allocated from the pool in one call
+    void reset() const { try_reset().value(); }
+    [[nodiscard]] expected<> try_reset() const noexcept;
+};
+
+class query_pool : public private_::derived_handle< VkDevice, VkQueryPool, &private_::device_dispatch::destroy_query_pool >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkQueryPool, &private_::device_dispatch::destroy_query_pool >;
+
+    query_pool()
+        : base_type( 1 )
+    {}
+
+    query_pool( device const& device, VkQueryPoolCreateInfo const& info );
+    query_pool( device const& device, VkQueryType type, uint32_t count, VkQueryPipelineStatisticFlags statistics = 0 );
+
+    [[nodiscard]] uint32_t count() const noexcept { return count_; }
+
+    // results of count queries from first, each stride bytes apart in data; without VK_QUERY_RESULT_WAIT_BIT a query
+    // the GPU has not reached yet fails the call with result::NOT_READY, which is no error for a polling reader
+    [[nodiscard]] expected<> try_results( uint32_t first, uint32_t count, std::span< std::byte > data, VkDeviceSize stride,
+                                          VkQueryResultFlags flags ) const noexcept;
+
+private:
+    uint32_t count_{ 0 };
+};
+
+// Writes a whole descriptor set from one block of memory laid out as its entries describe, in a single call
+class descriptor_update_template
+    : public private_::derived_handle< VkDevice, VkDescriptorUpdateTemplate, &private_::device_dispatch::destroy_descriptor_update_template >
+{
+public:
+    using base_type = private_::derived_handle< VkDevice, VkDescriptorUpdateTemplate, &private_::device_dispatch::destroy_descriptor_update_template >;
+
+    descriptor_update_template()
+        : base_type( 1 )
+    {}
+
+    descriptor_update_template( device const& device, VkDescriptorUpdateTemplateCreateInfo const& info );
+
+    // only for a template of VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET
+    void update( VkDescriptorSet const set, void const* const data ) const
+    {
+        assert( *this );
+        dispatch().update_descriptor_set_with_template( source_native(), set, native(), data );
+    }
+
+    // only for a template of VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR, layout and set as it was created with
+    void push( command_buffer const& buffer, VkPipelineLayout const layout, uint32_t const set, void const* const data ) const
+    {
+        assert( *this );
+        assert( nullptr != dispatch().cmd_push_descriptor_set_with_template );
+        dispatch().cmd_push_descriptor_set_with_template( buffer.native(), native(), layout, set, data );
+    }
+};
+
 } // namespace vkcpp
 
 #endif // _VKCPP_ELEMENTS_INCLUDED_
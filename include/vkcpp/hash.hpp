@@ -0,0 +1,61 @@
+#ifndef _VKCPP_HASH_INCLUDED_
+#define _VKCPP_HASH_INCLUDED_
+
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace vkcpp
+{
+namespace private_
+{
+// Canonical bytes of a create description, built field by field so padding and pointers never leak in. Equal keys
+// mean equal objects, so one key is both the hash input and the exact comparison that keeps a hash collision from
+// handing out the wrong object.
+class content_key
+{
+public:
+    template< typename value_type >
+        requires( std::has_unique_object_representations_v< value_type > || std::is_floating_point_v< value_type > )
+    content_key& add( value_type const& value )
+    {
+        auto const offset = bytes_.size();
+        bytes_.resize( offset + sizeof( value ) );
+        std::memcpy( bytes_.data() + offset, &value, sizeof( value ) );
+        return *this;
+    }
+
+    // the length goes first, so neighbouring ranges can not trade elements and still produce the same key
+    template< typename value_type >
+    content_key& add( std::span< value_type const > const values )
+    {
+        add( values.size() );
+        for( auto const& iv: values )
+        {
+            add( iv );
+        }
+        return *this;
+    }
+
+    content_key& add( std::string_view const text )
+    {
+        add( text.size() );
+        bytes_.append( text );
+        return *this;
+    }
+
+    [[nodiscard]] std::string const& bytes() const& noexcept { return bytes_; }
+    [[nodiscard]] std::string bytes() && noexcept { return std::move( bytes_ ); }
+    [[nodiscard]] size_t hash() const noexcept { return std::hash< std::string >()( bytes_ ); }
+
+private:
+    std::string bytes_;
+};
+
+} // namespace private_
+} // namespace vkcpp
+
+#endif // _VKCPP_HASH_INCLUDED_
@@ -0,0 +1,146 @@
+#ifndef _VKCPP_HOST_ALLOCATOR_INCLUDED_
+#define _VKCPP_HOST_ALLOCATOR_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace vkcpp
+{
+// Host memory the driver allocates through VkAllocationCallbacks, counted per allocation scope. Backends only hand out
+// and take back raw blocks; sizes, alignment and the counters are kept here, so every backend gets the same statistics.
+// Pass callbacks() to the instance or device::builder::use_allocation_callbacks; the allocator has to outlive them.
+class host_allocator
+{
+public:
+    enum class scope
+    {
+        COMMAND = VK_SYSTEM_ALLOCATION_SCOPE_COMMAND,
+        OBJECT = VK_SYSTEM_ALLOCATION_SCOPE_OBJECT,
+        CACHE = VK_SYSTEM_ALLOCATION_SCOPE_CACHE,
+        DEVICE = VK_SYSTEM_ALLOCATION_SCOPE_DEVICE,
+        INSTANCE = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+    };
+    static constexpr size_t const scope_count = 5;
+
+    struct statistics
+    {
+        size_t bytes{ 0 };
+        size_t count{ 0 };
+        size_t peak_bytes{ 0 };
+        size_t total_count{ 0 };
+    };
+
+    host_allocator( host_allocator& ) = delete;
+    host_allocator& operator=( host_allocator& ) = delete;
+    virtual ~host_allocator() = default;
+
+    [[nodiscard]] VkAllocationCallbacks const* callbacks() const noexcept { return &callbacks_; }
+
+    [[nodiscard]] statistics stats( scope allocation_scope ) const noexcept;
+    // totals over every scope, peak_bytes is the peak of the sum rather than the sum of the peaks
+    [[nodiscard]] statistics stats() const noexcept;
+
+    // raw backend interface, size and alignment given to release are those the block was acquired with
+    [[nodiscard]] virtual void* acquire( size_t size, size_t alignment, scope allocation_scope ) noexcept = 0;
+    virtual void release( void* memory, size_t size, size_t alignment, scope allocation_scope ) noexcept = 0;
+
+protected:
+    host_allocator();
+
+private:
+    struct counters
+    {
+        std::atomic< size_t > bytes{ 0 };
+        std::atomic< size_t > count{ 0 };
+        std::atomic< size_t > peak_bytes{ 0 };
+        std::atomic< size_t > total_count{ 0 };
+
+        void add( size_t size ) noexcept;
+        void remove( size_t size ) noexcept;
+        [[nodiscard]] statistics snapshot() const noexcept;
+    };
+
+    VkAllocationCallbacks callbacks_;
+    std::array< counters, scope_count > scope_counters_;
+    counters total_counters_;
+
+    void* allocate( size_t size, size_t alignment, scope allocation_scope ) noexcept;
+    void* reallocate( void* original, size_t size, size_t alignment, scope allocation_scope ) noexcept;
+    void free( void* memory ) noexcept;
+
+    static void* VKAPI_CALL allocate_callback( void* puser_data, size_t size, size_t alignment, VkSystemAllocationScope allocation_scope );
+    static void* VKAPI_CALL reallocate_callback( void* puser_data, void* poriginal, size_t size, size_t alignment, VkSystemAllocationScope allocation_scope );
+    static void VKAPI_CALL free_callback( void* puser_data, void* pmemory );
+};
+
+// Straight to the C runtime, only adds the counters
+class system_host_allocator : public host_allocator
+{
+public:
+    system_host_allocator() = default;
+
+    [[nodiscard]] void* acquire( size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+    void release( void* memory, size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+};
+
+// Size classes of powers of two carved out of large chunks, each class with its own free list. Blocks are reused but
+// chunks stay until the allocator goes away; requests above max_class_size go to the system.
+class pool_host_allocator : public host_allocator
+{
+public:
+    static constexpr size_t const min_class_size = 16;
+    static constexpr size_t const max_class_size = 4096;
+    static constexpr size_t const chunk_size = size_t( 64 ) << 10U;
+
+    pool_host_allocator() = default;
+    ~pool_host_allocator() override;
+
+    [[nodiscard]] void* acquire( size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+    void release( void* memory, size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+
+private:
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    struct alignas( 64 ) size_class
+    {
+        std::mutex mutex;
+        free_block* free_list{ nullptr };
+    };
+
+    static constexpr size_t const class_count = 9; // 16 .. 4096
+
+    std::array< size_class, class_count > classes_;
+    std::mutex chunk_mutex_;
+    std::vector< void* > chunks_;
+};
+
+// Command scope allocations live only for the duration of one call and never leave the thread making it, so they are
+// bumped out of a thread local chunk that rewinds once everything in it was freed. Every other scope, and anything
+// too large for a chunk, goes to the fallback.
+class arena_host_allocator : public host_allocator
+{
+public:
+    static constexpr size_t const chunk_size = size_t( 64 ) << 10U;
+
+    explicit arena_host_allocator( host_allocator& fallback )
+        : fallback_( fallback )
+    {}
+
+    [[nodiscard]] void* acquire( size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+    void release( void* memory, size_t size, size_t alignment, scope allocation_scope ) noexcept override;
+
+private:
+    host_allocator& fallback_;
+
+    [[nodiscard]] static bool fits( size_t size, size_t alignment, scope allocation_scope ) noexcept;
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_HOST_ALLOCATOR_INCLUDED_
@@ -0,0 +1,58 @@
+#ifndef _VKCPP_INSTRUMENT_INCLUDED_
+#define _VKCPP_INSTRUMENT_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <iosfwd>
+
+namespace vkcpp
+{
+namespace instrument
+{
+#ifdef VKCPP_INSTRUMENT_CALLS
+inline constexpr bool const enabled = true;
+#else
+inline constexpr bool const enabled = false;
+#endif
+
+// latency buckets by powers of two: bucket i holds calls of [2^(i-1), 2^i) nanoseconds, the last one everything longer
+inline constexpr size_t const histogram_size = 32;
+
+[[nodiscard]] std::string_view name( api_call call ) noexcept;
+
+struct call_statistics
+{
+    api_call call;
+    uint64_t count{ 0 };
+    uint64_t total_nanoseconds{ 0 };
+    std::array< uint64_t, histogram_size > histogram{};
+
+    [[nodiscard]] double average() const noexcept { return 0 < count ? static_cast< double >( total_nanoseconds ) / static_cast< double >( count ) : 0.0; }
+    // upper bound in nanoseconds of the bucket the given share of the calls falls in, 0.99 for the 99th percentile
+    [[nodiscard]] uint64_t percentile( double share ) const noexcept;
+};
+
+// Counts of every api_call since the process started, merged from the counters of all threads; the calls made during
+// a request are the difference of the snapshots taken around it.
+class snapshot
+{
+public:
+    // all zero without VKCPP_INSTRUMENT_CALLS
+    [[nodiscard]] static snapshot take();
+
+    [[nodiscard]] call_statistics const& operator[]( api_call const call ) const noexcept { return calls_[ static_cast< size_t >( call ) ]; }
+    [[nodiscard]] snapshot since( snapshot const& earlier ) const noexcept;
+
+    // one line for each call made at least once
+    void dump( std::ostream& stream ) const;
+
+private:
+    std::array< call_statistics, static_cast< size_t >( api_call::MAX_CALL ) > calls_;
+
+    snapshot() noexcept;
+};
+
+} // namespace instrument
+} // namespace vkcpp
+
+#endif // _VKCPP_INSTRUMENT_INCLUDED_
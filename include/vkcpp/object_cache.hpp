@@ -0,0 +1,98 @@
+#ifndef _VKCPP_OBJECT_CACHE_INCLUDED_
+#define _VKCPP_OBJECT_CACHE_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/hash.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vkcpp
+{
+// Interns the immutable objects pipelines are built from: shader modules by their SPIR-V, descriptor set layouts,
+// pipeline layouts and samplers by their create info. Asking twice for the same content hands out the same object;
+// it lives for as long as anyone holds it and the cache keeps it until trim() finds it unused. pNext chains of the
+// create infos are not part of the content and must be empty.
+// Immutable samplers and set layouts named in a create info are keyed by their own content, not by their handle, and
+// the layout made from them holds them alive. That takes handles this cache handed out; a layout naming any other
+// handle is created anew on every call and not kept, since its handles may come back later for different objects.
+class object_cache
+{
+public:
+    enum class kind
+    {
+        SHADER_MODULE,
+        DESCRIPTOR_SET_LAYOUT,
+        PIPELINE_LAYOUT,
+        SAMPLER,
+        MAX_KIND
+    };
+
+    struct statistics
+    {
+        size_t hits{ 0 };
+        size_t misses{ 0 };
+        size_t size{ 0 };
+    };
+
+    explicit object_cache( device const& device );
+    object_cache( object_cache& ) = delete;
+    object_cache& operator=( object_cache& ) = delete;
+
+    [[nodiscard]] std::shared_ptr< vkcpp::shader_module const > shader_module( std::span< uint32_t const > code );
+    [[nodiscard]] std::shared_ptr< vkcpp::descriptor_set_layout const > descriptor_set_layout( VkDescriptorSetLayoutCreateInfo const& info );
+    [[nodiscard]] std::shared_ptr< vkcpp::pipeline_layout const > pipeline_layout( VkPipelineLayoutCreateInfo const& info );
+    [[nodiscard]] std::shared_ptr< vkcpp::sampler const > sampler( VkSamplerCreateInfo const& info );
+
+    // destroys every object nobody but the cache holds any more, returns how many went
+    size_t trim();
+
+    // content keys of objects the cache holds, empty for handles it does not know; pipelines are keyed by them
+    [[nodiscard]] std::string shader_module_key( VkShaderModule module ) const;
+    [[nodiscard]] std::string pipeline_layout_key( VkPipelineLayout layout ) const;
+
+    [[nodiscard]] statistics stats( kind object_kind ) const;
+
+private:
+    using sources_type = std::vector< std::shared_ptr< void const > >;
+
+    template< typename handle_type >
+    struct table
+    {
+        std::unordered_map< std::string, std::shared_ptr< handle_type const > > objects;
+        // content key of every object in the table by its handle
+        std::unordered_map< typename handle_type::native_type, std::string > keys;
+        size_t hits{ 0 };
+        size_t misses{ 0 };
+    };
+
+    // an object together with the cached objects it was made from, which go only after it
+    template< typename handle_type >
+    struct with_sources
+    {
+        sources_type sources;
+        handle_type object;
+    };
+
+    device_reference device_;
+    mutable std::mutex mutex_;
+    table< vkcpp::shader_module > shader_modules_;
+    table< vkcpp::descriptor_set_layout > descriptor_set_layouts_;
+    table< vkcpp::pipeline_layout > pipeline_layouts_;
+    table< vkcpp::sampler > samplers_;
+
+    template< typename handle_type, typename create_type >
+    std::shared_ptr< handle_type const > intern( table< handle_type >& objects, private_::content_key&& key, sources_type&& sources,
+                                                 create_type const& create );
+    template< typename handle_type >
+    static bool add_source( private_::content_key& key, sources_type& sources, table< handle_type > const& objects,
+                            typename handle_type::native_type native );
+    template< typename handle_type >
+    static size_t trim( table< handle_type >& objects );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_OBJECT_CACHE_INCLUDED_
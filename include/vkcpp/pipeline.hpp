@@ -0,0 +1,173 @@
+#ifndef _VKCPP_PIPELINE_INCLUDED_
+#define _VKCPP_PIPELINE_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/hash.hpp>
+#include <vkcpp/pipeline_cache.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+namespace vkcpp
+{
+struct shader_stage
+{
+    VkShaderStageFlagBits stage{ VK_SHADER_STAGE_COMPUTE_BIT };
+    VkShaderModule module{ VK_NULL_HANDLE };
+    // content of the module, what object_cache::shader_module_key() gives for it; stages are keyed on it rather than on
+    // the handle, which the driver may hand out again for a different module
+    std::string module_key;
+    std::string entry_point{ "main" };
+    std::vector< VkSpecializationMapEntry > specialization_entries;
+    std::vector< std::byte > specialization_data;
+
+    void add_to( private_::content_key& key ) const;
+};
+
+// Self contained descriptions of a pipeline, owning everything the create info points at, so they can be queued and
+// compared by content. Fixed function state is kept in the Vulkan structs; their pNext chains are not supported.
+// Shader modules, the layout and the render pass are compared by the content keys given along with them.
+struct compute_pipeline_description
+{
+    shader_stage stage;
+    VkPipelineLayout layout{ VK_NULL_HANDLE };
+    // what object_cache::pipeline_layout_key() gives for the layout
+    std::string layout_key;
+    VkPipelineCreateFlags flags{ 0 };
+
+    [[nodiscard]] private_::content_key key() const;
+    [[nodiscard]] pipeline create( device_reference device, VkPipelineCache cache = VK_NULL_HANDLE ) const;
+};
+
+struct graphics_pipeline_description
+{
+    std::vector< shader_stage > stages;
+    std::vector< VkVertexInputBindingDescription > vertex_bindings;
+    std::vector< VkVertexInputAttributeDescription > vertex_attributes;
+    VkPrimitiveTopology topology{ VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST };
+    bool primitive_restart{ false };
+    // zero leaves out the tessellation state
+    uint32_t patch_control_points{ 0 };
+    // counts only, viewport and scissor are dynamic by default; static ones go in the vectors
+    uint32_t viewport_count{ 1 };
+    uint32_t scissor_count{ 1 };
+    std::vector< VkViewport > viewports;
+    std::vector< VkRect2D > scissors;
+    VkPipelineRasterizationStateCreateInfo rasterization{ .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+                                                          .pNext = nullptr,
+                                                          .polygonMode = VK_POLYGON_MODE_FILL,
+                                                          .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+                                                          .lineWidth = 1.0F };
+    VkPipelineMultisampleStateCreateInfo multisample{ .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                                                      .pNext = nullptr,
+                                                      .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT };
+    VkPipelineDepthStencilStateCreateInfo depth_stencil{ .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO, .pNext = nullptr };
+    bool logic_op_enable{ false };
+    VkLogicOp logic_op{ VK_LOGIC_OP_COPY };
+    std::vector< VkPipelineColorBlendAttachmentState > blend_attachments;
+    std::array< float, 4 > blend_constants{};
+    std::vector< VkDynamicState > dynamic_states{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineLayout layout{ VK_NULL_HANDLE };
+    std::string layout_key;
+    VkRenderPass render_pass{ VK_NULL_HANDLE };
+    // any text that tells render passes of different content apart, the handle may be handed out again for another one
+    std::string render_pass_key;
+    uint32_t subpass{ 0 };
+    VkPipelineCreateFlags flags{ 0 };
+
+    [[nodiscard]] private_::content_key key() const;
+    [[nodiscard]] pipeline create( device_reference device, VkPipelineCache cache = VK_NULL_HANDLE ) const;
+};
+
+// Compiles pipelines on worker threads of its own so the first use of a variant never stalls the caller. Requests
+// with the same content share one compilation and one pipeline; the future lets the caller draw with a fallback
+// until the pipeline is ready. Compiled pipelines stay with the compiler and are handed out for as long as it lives.
+class pipeline_compiler
+{
+public:
+    using shared_pipeline = std::shared_ptr< pipeline const >;
+    using future_type = std::shared_future< shared_pipeline >;
+
+    struct statistics
+    {
+        size_t requested{ 0 };
+        size_t deduplicated{ 0 };
+        size_t compiled{ 0 };
+        size_t failed{ 0 };
+    };
+
+    // cache is shared by the workers, the driver synchronises pipeline creation with it; nothing may merge into it
+    // while the compiler lives
+    explicit pipeline_compiler( device const& device, VkPipelineCache cache = VK_NULL_HANDLE,
+                                size_t thread_count = std::max( std::thread::hardware_concurrency() / 2, 1U ) );
+    // creates under the cache's creation_lock(), so merges into it wait for the compilations running
+    pipeline_compiler( device const& device, persistent_pipeline_cache const& cache,
+                       size_t thread_count = std::max( std::thread::hardware_concurrency() / 2, 1U ) );
+    pipeline_compiler( pipeline_compiler& ) = delete;
+    pipeline_compiler& operator=( pipeline_compiler& ) = delete;
+    // requests not started yet are dropped, their futures report a broken promise
+    ~pipeline_compiler();
+
+    [[nodiscard]] future_type compile( compute_pipeline_description const& description ) { return compile_impl( description ); }
+    [[nodiscard]] future_type compile( graphics_pipeline_description const& description ) { return compile_impl( description ); }
+
+    [[nodiscard]] size_t pending() const;
+    [[nodiscard]] statistics stats() const;
+
+private:
+    using description_type = std::variant< compute_pipeline_description, graphics_pipeline_description >;
+
+    struct request
+    {
+        std::string key;
+        description_type description;
+        std::promise< shared_pipeline > promise;
+    };
+
+    device_reference device_;
+    VkPipelineCache cache_;
+    persistent_pipeline_cache const* ppersistent_cache_{ nullptr };
+    mutable std::mutex mutex_;
+    std::condition_variable_any condition_;
+    std::deque< request > requests_;
+    std::unordered_map< std::string, future_type > pipelines_;
+    statistics stats_;
+    std::vector< std::jthread > workers_;
+
+    template< typename pipeline_description >
+    future_type compile_impl( pipeline_description const& description );
+    void start( size_t thread_count );
+    void run( std::stop_token const& stop );
+};
+
+template< typename pipeline_description >
+pipeline_compiler::future_type pipeline_compiler::compile_impl( pipeline_description const& description )
+{
+    auto key = description.key();
+    std::lock_guard< std::mutex > lock( mutex_ );
+    ++stats_.requested;
+    auto const ip = pipelines_.find( key.bytes() );
+    if( ip != pipelines_.end() )
+    {
+        ++stats_.deduplicated;
+        return ip->second;
+    }
+
+    std::promise< shared_pipeline > promise;
+    auto future = promise.get_future().share();
+    pipelines_.emplace( key.bytes(), future );
+    requests_.push_back( request{ std::move( key ).bytes(), description, std::move( promise ) } );
+    condition_.notify_one();
+    return future;
+}
+
+} // namespace vkcpp
+
+#endif // _VKCPP_PIPELINE_INCLUDED_
@@ -0,0 +1,59 @@
+#ifndef _VKCPP_PIPELINE_CACHE_INCLUDED_
+#define _VKCPP_PIPELINE_CACHE_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+
+namespace vkcpp
+{
+// Pipeline cache kept on disk between runs. The file is mapped rather than read and only handed to the driver when
+// its header names this very device, so a cache from another GPU or driver build starts out cold instead of being
+// rejected half way. Worker threads compile into caches of their own, which are merged back into the shared one, and
+// the result replaces the file atomically when the cache goes away.
+class persistent_pipeline_cache
+{
+public:
+    persistent_pipeline_cache( device const& device, physical_device physical_device, std::filesystem::path path );
+    persistent_pipeline_cache( persistent_pipeline_cache& ) = delete;
+    persistent_pipeline_cache& operator=( persistent_pipeline_cache& ) = delete;
+    // saves, a cache that can not be written is lost rather than thrown from here
+    ~persistent_pipeline_cache();
+
+    [[nodiscard]] pipeline_cache const& cache() const noexcept { return cache_; }
+    [[nodiscard]] VkPipelineCache native() const noexcept { return cache_.native(); }
+
+    // whether the file was there and made for this device
+    [[nodiscard]] bool warm() const noexcept { return warm_; }
+
+    // vkMergePipelineCaches needs its destination externally synchronised against vkCreate*Pipelines, so pipelines
+    // created with native() have to be created under this lock; merge() waits for all of them to let go of it
+    [[nodiscard]] std::shared_lock< std::shared_mutex > creation_lock() const { return std::shared_lock< std::shared_mutex >( mutex_ ); }
+
+    // an empty cache for one worker thread to compile into without contending on the shared one
+    [[nodiscard]] pipeline_cache make_worker_cache() const { return pipeline_cache( device_ ); }
+    void merge( std::span< VkPipelineCache const > worker_caches );
+    void merge( pipeline_cache const& worker_cache ) { merge( worker_cache.natives() ); }
+
+    // writes a file of its own next to the cache, flushes it to disk and renames it over the cache, so neither a
+    // crash nor a concurrent save leaves a torn cache behind
+    void save() const;
+
+    // checks the VkPipelineCacheHeaderVersionOne at the front of the data against the device
+    [[nodiscard]] static bool compatible( std::span< std::byte const > data, physical_device::property const& property ) noexcept;
+
+private:
+    device_reference device_;
+    physical_device::property property_;
+    std::filesystem::path path_;
+    bool warm_{ false };
+    pipeline_cache cache_;
+    // shared by pipeline creation and save(), held exclusive by merge()
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_PIPELINE_CACHE_INCLUDED_
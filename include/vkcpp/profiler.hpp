@@ -0,0 +1,185 @@
+#ifndef _VKCPP_PROFILER_INCLUDED_
+#define _VKCPP_PROFILER_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vkcpp
+{
+// Measures GPU time of nested zones of recorded commands with timestamp queries, and optionally counts pipeline
+// statistics such as shader invocations for the same zones. Every frame in flight has query pools of its own; when a
+// slot comes round again its results are read back without waiting, so a frame the GPU has not finished yet is
+// dropped rather than stalled on. Disabled, a zone costs one relaxed load.
+class profiler
+{
+public:
+    static constexpr size_t const no_parent = std::numeric_limits< size_t >::max();
+
+    // one node of the zone tree, zones() lists them depth first with the times in nanoseconds
+    struct zone
+    {
+        std::string name;
+        size_t parent{ no_parent };
+        uint32_t depth{ 0 };
+        uint64_t sample_count{ 0 };
+        double last{ 0.0 };
+        // over the last window samples
+        double average{ 0.0 };
+        double min{ 0.0 };
+        double max{ 0.0 };
+        // of the last complete frame, children included, one for each bit of statistic_flags() from the lowest up
+        std::vector< uint64_t > statistics;
+    };
+
+    class scoped_zone
+    {
+    public:
+        scoped_zone( profiler& profiler, command_buffer const& buffer, std::string_view name );
+        scoped_zone( scoped_zone& ) = delete;
+        scoped_zone& operator=( scoped_zone& ) = delete;
+        ~scoped_zone();
+
+    private:
+        profiler* pprofiler_{ nullptr };
+        command_buffer buffer_;
+        uint32_t query_{ 0 };
+    };
+
+    // family_index is the queue family the profiled buffers are submitted to, its timestampValidBits masks the ticks;
+    // statistics need pipelineStatisticsQuery enabled on the device and are left out where physical_device::feature
+    // does not have it. Zones nest within one command buffer, and buffers recorded on different threads at the same
+    // time each keep zones of their own; statistics are not counted inside a render pass.
+    profiler( device const& device, physical_device physical_device, device::queue::family::id_type family_index, uint32_t frame_count = 2,
+              uint32_t max_zones = 1024, size_t window = 64, VkQueryPipelineStatisticFlags statistics = 0 );
+    profiler( profiler& ) = delete;
+    profiler& operator=( profiler& ) = delete;
+    ~profiler();
+
+    // false when the queue family can not write timestamps at all, every zone is a no-op then
+    [[nodiscard]] bool supported() const noexcept { return 0 != tick_mask_; }
+
+    // the statistics actually counted
+    [[nodiscard]] VkQueryPipelineStatisticFlags statistic_flags() const noexcept { return statistics_; }
+
+    void enable( bool const enabled ) noexcept { enabled_.store( enabled && supported(), std::memory_order_relaxed ); }
+    [[nodiscard]] bool enabled() const noexcept { return enabled_.load( std::memory_order_relaxed ); }
+
+    // on the first buffer recorded for a frame, before any of its zones: collects what the GPU finished of the frame
+    // that last used the slot and resets its queries
+    void begin_frame( command_buffer const& buffer );
+
+    [[nodiscard]] scoped_zone scope( command_buffer const& buffer, std::string_view const name ) { return scoped_zone( *this, buffer, name ); }
+
+    // called by begin_frame for every zone of a finished frame with its begin and end in nanoseconds of the device
+    // timestamp domain; it runs under the profiler's lock, so it must not call back into the profiler
+    using zone_listener = std::function< void( std::string_view name, uint32_t depth, double begin, double end ) >;
+    void set_zone_listener( zone_listener listener );
+
+    [[nodiscard]] std::vector< zone > zones() const;
+    // frames whose results were not available yet when their slot came round again
+    [[nodiscard]] uint64_t dropped_frames() const;
+
+private:
+    struct node;
+    struct frame_slot;
+
+    // zones open in one command buffer, innermost last
+    struct open_zones
+    {
+        std::vector< size_t > zones;
+        // statistics query of the segment counting in the buffer, it has to end in the buffer it began in
+        uint32_t segment{ 0 };
+    };
+
+    std::atomic< bool > enabled_;
+    double period_;
+    uint64_t tick_mask_;
+    VkQueryPipelineStatisticFlags statistics_;
+    uint32_t statistic_count_;
+    uint32_t max_zones_;
+    size_t window_;
+    mutable std::mutex mutex_;
+    std::vector< node > nodes_;
+    std::vector< size_t > roots_;
+    std::vector< frame_slot > slots_;
+    size_t current_{ 0 };
+    std::unordered_map< VkCommandBuffer, open_zones > open_;
+    uint64_t dropped_{ 0 };
+    zone_listener listener_;
+
+    [[nodiscard]] bool begin_zone( command_buffer const& buffer, std::string_view name, uint32_t& query );
+    void end_zone( command_buffer const& buffer, uint32_t query );
+    void collect( frame_slot& slot );
+    void collect_statistics( frame_slot& slot );
+    [[nodiscard]] size_t child_of( size_t parent, std::string_view name );
+};
+
+// Hardware counters of VK_KHR_performance_query over one span of commands. A driver may need the commands run several
+// times to sample every counter asked for, once for each of passes() with submit_info( pass ) chained into the submit,
+// and the device has to hold a profiling_lock while such buffers are recorded and executed.
+class performance_query
+{
+public:
+    struct counter
+    {
+        uint32_t index;
+        VkPerformanceCounterKHR properties;
+        VkPerformanceCounterDescriptionKHR description;
+
+        [[nodiscard]] std::string_view name() const noexcept { return std::string_view( static_cast< char const* >( description.name ) ); }
+    };
+
+    class profiling_lock
+    {
+    public:
+        explicit profiling_lock( device const& device, uint64_t timeout = std::numeric_limits< uint64_t >::max() );
+        profiling_lock( profiling_lock& ) = delete;
+        profiling_lock& operator=( profiling_lock& ) = delete;
+        ~profiling_lock();
+
+    private:
+        device_reference device_;
+    };
+
+    // empty where the driver has no counters for the family, which is how to tell the extension is usable at all
+    [[nodiscard]] static std::vector< counter > enumerate( physical_device physical_device, device::queue::family::id_type family_index );
+
+    // counter_indices are counter::index values of enumerate() for the same family; the device needs
+    // device_extension::performance_query
+    performance_query( device const& device, physical_device physical_device, device::queue::family::id_type family_index,
+                       std::span< uint32_t const > counter_indices );
+
+    [[nodiscard]] uint32_t passes() const noexcept { return passes_; }
+    [[nodiscard]] size_t counter_count() const noexcept { return counter_count_; }
+
+    [[nodiscard]] VkPerformanceQuerySubmitInfoKHR submit_info( uint32_t const pass ) const noexcept
+    {
+        assert( pass < passes_ );
+        return VkPerformanceQuerySubmitInfoKHR{ .sType = VK_STRUCTURE_TYPE_PERFORMANCE_QUERY_SUBMIT_INFO_KHR, .pNext = nullptr, .counterPassIndex = pass };
+    }
+
+    // not in the buffer that begins the query
+    void reset( command_buffer const& buffer ) const { buffer.reset_queries( pool_.native(), 0, 1 ); }
+    // counters of command buffer scope want this to be the first command of the buffer
+    void begin( command_buffer const& buffer ) const { buffer.begin_query( pool_.native(), 0 ); }
+    void end( command_buffer const& buffer ) const { buffer.end_query( pool_.native(), 0 ); }
+
+    // results has room for counter_count() values, in the order of counter_indices; fails with result::NOT_READY
+    // until every pass has run, without waiting for it
+    [[nodiscard]] expected<> try_results( std::span< VkPerformanceCounterResultKHR > results ) const noexcept;
+
+private:
+    query_pool pool_;
+    uint32_t passes_{ 0 };
+    size_t counter_count_{ 0 };
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_PROFILER_INCLUDED_
@@ -0,0 +1,124 @@
+#ifndef _VKCPP_REPORT_SINK_INCLUDED_
+#define _VKCPP_REPORT_SINK_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/ring.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace vkcpp
+{
+namespace dbg
+{
+// Takes debug report messages off the thread that raised them: callback() copies a message into a bounded lock-free
+// ring and returns, a background thread hands it on to the target callback. Repeats of a message code on the same
+// object within the dedup window are counted instead of delivered, deliveries above max_rate a second are dropped,
+// and PERF messages are only counted, per message code. A message arriving with the ring full is dropped and counted.
+class async_sink
+{
+public:
+    static constexpr size_t const max_message_size = 1024;
+    static constexpr size_t const max_prefix_size = 32;
+
+    struct statistics
+    {
+        uint64_t received{ 0 };
+        uint64_t delivered{ 0 };
+        uint64_t duplicates{ 0 };
+        uint64_t rate_limited{ 0 };
+        // lost to a full ring
+        uint64_t dropped{ 0 };
+    };
+
+    struct perf_counter
+    {
+        int message_code;
+        uint64_t count;
+        std::string last_message;
+    };
+
+    // capacity is rounded up to a power of two; a max_rate of 0 delivers without limit
+    explicit async_sink( callback_type target, void* puser = nullptr, size_t capacity = 1024,
+                         std::chrono::milliseconds dedup_window = std::chrono::milliseconds( 1000 ), uint32_t max_rate = 100 );
+    async_sink( async_sink& ) = delete;
+    async_sink& operator=( async_sink& ) = delete;
+    // delivers what is still queued before it returns
+    ~async_sink();
+
+    // for dbg::report in place of the target; the calls it makes never ask the driver to abort them, and the sink has
+    // to outlive the report
+    [[nodiscard]] callback_type callback();
+
+    // waits until every message received so far has been delivered or filtered
+    void flush();
+
+    [[nodiscard]] statistics stats() const;
+    [[nodiscard]] std::vector< perf_counter > perf_counters() const;
+
+private:
+    struct message
+    {
+        flag report_flag;
+        object object_type;
+        unsigned long long object_id;
+        int location;
+        int message_code;
+        uint32_t prefix_size;
+        uint32_t message_size;
+        std::array< char, max_prefix_size > prefix;
+        std::array< char, max_message_size > text;
+    };
+
+    struct repeat
+    {
+        std::chrono::steady_clock::time_point delivered;
+        uint64_t suppressed;
+    };
+
+    struct repeat_key_hash
+    {
+        size_t operator()( std::pair< int, unsigned long long > const& key ) const noexcept
+        {
+            return std::hash< unsigned long long >()( key.second ) * 31 + std::hash< int >()( key.first );
+        }
+    };
+
+    callback_type target_;
+    void* puser_data_;
+    std::chrono::steady_clock::duration dedup_window_;
+    uint32_t max_rate_;
+
+    private_::mpsc_ring< message > ring_;
+    std::atomic< uint64_t > received_{ 0 };
+    std::atomic< uint64_t > dropped_{ 0 };
+    // messages that made it into the ring, flush() waits for the drain thread to have handled as many
+    std::atomic< uint64_t > queued_{ 0 };
+    // bumped by every producer, the drain thread sleeps on it
+    std::atomic< uint32_t > signal_{ 0 };
+    std::atomic< uint64_t > handled_{ 0 };
+
+    // the drain thread's state, stats() and perf_counters() read it under the lock
+    mutable std::mutex mutex_;
+    std::unordered_map< std::pair< int, unsigned long long >, repeat, repeat_key_hash > repeats_;
+    std::unordered_map< int, perf_counter > perf_counters_;
+    statistics stats_;
+    double tokens_;
+    std::chrono::steady_clock::time_point refilled_;
+
+    std::jthread thread_;
+
+    bool push( flag flag, object object, unsigned long long object_id, int location, int message_code, std::string_view prefix,
+               std::string_view text ) noexcept;
+    bool pop( message& payload ) noexcept;
+    void drain( std::stop_token stop );
+    void handle( message const& payload );
+};
+
+} // namespace dbg
+} // namespace vkcpp
+
+#endif // _VKCPP_REPORT_SINK_INCLUDED_
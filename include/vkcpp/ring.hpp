@@ -0,0 +1,107 @@
+#ifndef _VKCPP_RING_INCLUDED_
+#define _VKCPP_RING_INCLUDED_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace vkcpp
+{
+namespace private_
+{
+// Bounded lock-free ring for many producers and a single consumer. Slots are written and read in place, so a
+// slot's members keep their capacity from one round to the next and the steady state does not allocate.
+template< typename value_type >
+class mpsc_ring
+{
+public:
+    explicit mpsc_ring( size_t const capacity )
+        : mask_( std::bit_ceil( std::max( capacity, size_t( 2 ) ) ) - 1 )
+        , cells_( std::make_unique< cell[] >( mask_ + 1 ) )
+    {
+        for( size_t ic = 0; ic <= mask_; ++ic )
+        {
+            cells_[ ic ].sequence.store( ic, std::memory_order_relaxed );
+        }
+    }
+
+    mpsc_ring( mpsc_ring& ) = delete;
+    mpsc_ring& operator=( mpsc_ring& ) = delete;
+
+    // fill is called with the slot to write, returns false when the ring is full; fill runs with the slot claimed and
+    // the consumer stuck on it until it returns, so anything that may throw belongs before try_push
+    template< typename fill_type >
+    bool try_push( fill_type&& fill )
+    {
+        static_assert( std::is_nothrow_invocable_v< fill_type&, value_type& >, "an mpsc_ring fill must not throw" );
+        auto position = enqueue_position_.load( std::memory_order_relaxed );
+        while( true )
+        {
+            auto& target = cells_[ position & mask_ ];
+            auto const sequence = target.sequence.load( std::memory_order_acquire );
+            auto const difference = static_cast< std::ptrdiff_t >( sequence ) - static_cast< std::ptrdiff_t >( position );
+            if( 0 == difference )
+            {
+                if( enqueue_position_.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                {
+                    fill( target.value );
+                    target.sequence.store( position + 1, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( 0 > difference )
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueue_position_.load( std::memory_order_relaxed );
+            }
+        }
+    }
+
+    // drain is called with the oldest slot, returns false when the ring is empty; only one thread may pop
+    template< typename drain_type >
+    bool try_pop( drain_type&& drain )
+    {
+        auto& source = cells_[ dequeue_position_ & mask_ ];
+        auto const sequence = source.sequence.load( std::memory_order_acquire );
+        if( sequence != dequeue_position_ + 1 )
+        {
+            return false;
+        }
+        drain( source.value );
+        source.sequence.store( dequeue_position_ + mask_ + 1, std::memory_order_release );
+        ++dequeue_position_;
+        return true;
+    }
+
+    // consumer side only
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return cells_[ dequeue_position_ & mask_ ].sequence.load( std::memory_order_acquire ) != dequeue_position_ + 1;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    struct cell
+    {
+        std::atomic< size_t > sequence;
+        value_type value;
+    };
+
+    size_t const mask_;
+    std::unique_ptr< cell[] > cells_;
+    alignas( 64 ) std::atomic< size_t > enqueue_position_{ 0 };
+    alignas( 64 ) size_t dequeue_position_{ 0 };
+};
+
+} // namespace private_
+} // namespace vkcpp
+
+#endif // _VKCPP_RING_INCLUDED_
@@ -0,0 +1,60 @@
+#ifndef _VKCPP_SCHEDULER_INCLUDED_
+#define _VKCPP_SCHEDULER_INCLUDED_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkcpp
+{
+// Fixed set of worker threads that run index ranges with work stealing. Every thread starts on a contiguous block of
+// indices, takes from the front of its own queue and steals from the back of the others once it runs dry, so uneven
+// tasks still keep every thread busy.
+class task_scheduler
+{
+public:
+    using task_type = std::function< void( size_t index ) >;
+
+    // thread_count includes the thread calling parallel_for, which works alongside the workers
+    explicit task_scheduler( size_t thread_count = std::thread::hardware_concurrency() );
+    task_scheduler( task_scheduler& ) = delete;
+    task_scheduler& operator=( task_scheduler& ) = delete;
+    ~task_scheduler();
+
+    // runs task for every index in [0, count) and returns once all of them are done, rethrowing the first exception
+    // a task threw; calls from several threads are run one after the other
+    void parallel_for( size_t count, task_type const& task );
+
+    [[nodiscard]] size_t thread_count() const noexcept { return queues_.size(); }
+
+private:
+    struct alignas( 64 ) work_queue
+    {
+        std::mutex mutex;
+        std::deque< size_t > indices;
+    };
+
+    std::vector< std::unique_ptr< work_queue > > queues_;
+    std::atomic< task_type const* > ptask_{ nullptr };
+    std::atomic< size_t > remaining_{ 0 };
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable_any start_;
+    std::condition_variable done_;
+    uint64_t generation_{ 0 };
+    std::exception_ptr error_;
+    std::vector< std::jthread > workers_;
+
+    bool try_run( size_t self );
+    void run( std::stop_token const& stop, size_t self );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_SCHEDULER_INCLUDED_
@@ -0,0 +1,170 @@
+#ifndef _VKCPP_SUBMIT_INCLUDED_
+#define _VKCPP_SUBMIT_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+#include <vkcpp/ring.hpp>
+#include <vkcpp/sync.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace vkcpp
+{
+// One unit of queue work. Values are only needed for timeline semaphores, when given they pair up with the
+// semaphores of the same list and binary semaphores in it take any value.
+struct submission
+{
+    std::span< VkCommandBuffer const > command_buffers;
+    std::span< VkSemaphore const > wait_semaphores;
+    std::span< VkPipelineStageFlags const > wait_stages;
+    std::span< uint64_t const > wait_values;
+    std::span< VkSemaphore const > signal_semaphores;
+    std::span< uint64_t const > signal_values;
+    VkFence fence{ VK_NULL_HANDLE };
+};
+
+namespace private_
+{
+// Flattened copy of a run of submissions that turns into as few vkQueueSubmit calls as the fences allow
+struct submission_batch
+{
+    struct entry
+    {
+        uint32_t command_buffer_offset;
+        uint32_t command_buffer_count;
+        uint32_t wait_offset;
+        uint32_t wait_count;
+        uint32_t signal_offset;
+        uint32_t signal_count;
+        bool timeline;
+        VkFence fence;
+    };
+
+    std::vector< entry > entries;
+    std::vector< VkCommandBuffer > command_buffers;
+    std::vector< VkSemaphore > semaphores;
+    std::vector< VkPipelineStageFlags > stages;
+    std::vector< uint64_t > values;
+    std::vector< VkSubmitInfo > infos;
+    std::vector< VkTimelineSemaphoreSubmitInfo > timeline_infos;
+    std::chrono::steady_clock::time_point oldest;
+
+    void append( submission const& work );
+    void clear() noexcept;
+
+    // tail_fence, when given, signals once everything in the batch is done
+    void submit( device::queue const& queue, VkFence tail_fence = VK_NULL_HANDLE );
+};
+
+} // namespace private_
+
+// Collects submissions from any number of threads and coalesces them into vkQueueSubmit calls with one
+// VkSubmitInfo each. A batch goes out once it holds max_batch_size submissions, once its oldest submission is
+// older than the deadline, or on flush. A vkQueueSubmit takes a single fence, so a fenced submission closes
+// the call it is in; queue ordering keeps the meaning of the fence intact.
+class submission_batcher
+{
+public:
+    submission_batcher( device::queue queue, size_t max_batch_size, std::chrono::nanoseconds deadline = std::chrono::nanoseconds::zero() );
+    submission_batcher( submission_batcher& ) = delete;
+    submission_batcher& operator=( submission_batcher& ) = delete;
+    ~submission_batcher();
+
+    void add( submission const& work );
+    void flush();
+
+    [[nodiscard]] size_t pending() const;
+    [[nodiscard]] device::queue const& queue() const noexcept { return queue_; }
+
+private:
+    device::queue queue_;
+    size_t max_batch_size_;
+    std::chrono::nanoseconds deadline_;
+    mutable std::mutex mutex_;
+    std::mutex submit_mutex_;
+    std::condition_variable_any condition_;
+    private_::submission_batch pending_;
+    private_::submission_batch spare_;
+    VkResult deferred_status_{ VK_SUCCESS };
+    std::jthread thread_;
+
+    void flush_impl();
+    void throw_deferred();
+    void run( std::stop_token const& stop );
+};
+
+// Thread-safe front-end of one VkQueue. Producers push into a lock-free ring and a single submitter thread owns
+// the queue, drains the ring into batched vkQueueSubmit calls and reports completion once the batch fence signals.
+class queue_submitter
+{
+public:
+    using completion_type = std::function< void( VkResult ) >;
+
+    queue_submitter( device const& device, device::queue queue, size_t capacity = 1024, size_t max_batch_size = 64,
+                     std::chrono::nanoseconds poll_interval = std::chrono::microseconds( 100 ) );
+    queue_submitter( queue_submitter& ) = delete;
+    queue_submitter& operator=( queue_submitter& ) = delete;
+    ~queue_submitter();
+
+    // completion runs on the submitter thread, with VK_SUCCESS or the error the submission or its fence failed with;
+    // an exception thrown out of it has nowhere to go and is dropped
+    void submit( submission const& work, completion_type completion );
+    [[nodiscard]] std::future< void > submit( submission const& work );
+
+private:
+    struct job
+    {
+        std::vector< VkCommandBuffer > command_buffers;
+        std::vector< VkSemaphore > wait_semaphores;
+        std::vector< VkPipelineStageFlags > wait_stages;
+        std::vector< uint64_t > wait_values;
+        std::vector< VkSemaphore > signal_semaphores;
+        std::vector< uint64_t > signal_values;
+        VkFence fence{ VK_NULL_HANDLE };
+        completion_type completion;
+
+        job() = default;
+        job( submission const& work, completion_type&& i_completion );
+
+        void swap( job& other ) noexcept;
+        [[nodiscard]] submission view() const noexcept;
+    };
+
+    struct in_flight
+    {
+        VkFence fence;
+        std::vector< completion_type > completions;
+    };
+
+    VkDevice device_;
+    device::queue queue_;
+    size_t max_batch_size_;
+    std::chrono::nanoseconds poll_interval_;
+    fence_pool fences_;
+    private_::mpsc_ring< job > ring_;
+    std::atomic< uint32_t > wake_{ 0 };
+    private_::submission_batch batch_;
+    // the job being moved from the ring into the batch
+    job current_;
+    std::vector< completion_type > completions_;
+    // acquired for the next batch, kept when the batch fails to go out since it was never submitted
+    VkFence fence_{ VK_NULL_HANDLE };
+    std::deque< in_flight > in_flight_;
+    std::jthread thread_;
+
+    void wake() noexcept;
+    size_t drain();
+    void fail( VkResult status ) noexcept;
+    void retire( bool block );
+    void run( std::stop_token const& stop );
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_SUBMIT_INCLUDED_
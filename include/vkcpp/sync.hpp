@@ -0,0 +1,134 @@
+#ifndef _VKCPP_SYNC_INCLUDED_
+#define _VKCPP_SYNC_INCLUDED_
+
+#include <vkcpp/elements.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace vkcpp
+{
+// Recycles fences instead of creating one per submission. Fences handed back after a submit stay pending
+// until they signal and are then reset together with every other signaled fence in one vkResetFences.
+class fence_pool
+{
+public:
+    explicit fence_pool( device const& device, size_t initial_count = 0 );
+    fence_pool( fence_pool& ) = delete;
+    fence_pool& operator=( fence_pool& ) = delete;
+    // destroys every fence the pool created, the ones still acquired included, so none may be in use any more
+    ~fence_pool();
+
+    // returns an unsignaled fence, reusing a recycled one when there is any
+    [[nodiscard]] VkFence acquire();
+
+    // a submitted fence is kept until it signals, one that never got submitted is reusable right away
+    void release( VkFence fence, bool submitted = true );
+
+    // resets every released fence that has signaled and makes it available again, returns how many were recycled
+    size_t recycle();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t available() const;
+
+private:
+    VkDevice device_;
+    private_::device_dispatch const* pdispatch_;
+    mutable std::mutex mutex_;
+    std::vector< VkFence > free_;
+    std::vector< VkFence > pending_;
+    std::vector< VkFence > signaled_;
+    // every fence made, wherever it is now
+    std::vector< VkFence > created_;
+
+    VkFence create();
+    size_t recycle_impl();
+};
+
+// How a host thread waits for fences. BLOCK hands the wait straight to vkWaitForFences, which usually sleeps in the
+// kernel; for jobs of a few tens of microseconds waking up from that sleep takes longer than the job, so the other
+// modes poll vkGetFenceStatus first. ADAPTIVE sizes that spin from how long recent waits took and blocks right away
+// once the waits have grown longer than the spin budget.
+class wait_policy
+{
+public:
+    enum class mode
+    {
+        BLOCK,
+        SPIN_THEN_BLOCK,
+        ADAPTIVE
+    };
+
+    // spin_budget is the whole spin for SPIN_THEN_BLOCK and the most ADAPTIVE ever spins
+    explicit wait_policy( mode wait_mode = mode::ADAPTIVE, std::chrono::nanoseconds spin_budget = std::chrono::microseconds( 200 ) );
+    wait_policy( wait_policy& ) = delete;
+    wait_policy& operator=( wait_policy& ) = delete;
+
+    template< derived_handle_kind handle_kind >
+    void wait( fence< handle_kind > const& fence, unsigned long long const timeout )
+    {
+        try_wait( fence, timeout ).value();
+    }
+
+    // waits for all the fences, a wait that runs out of time fails with result::TIMEOUT
+    template< derived_handle_kind handle_kind >
+    [[nodiscard]] expected<> try_wait( fence< handle_kind > const& fence, unsigned long long const timeout ) noexcept
+    {
+        return try_wait( fence.source_native(), fence.dispatch(), fence.natives(), timeout );
+    }
+
+    // for fences not owned by a vkcpp::fence, like the ones of a fence_pool
+    [[nodiscard]] expected<> try_wait( VkDevice device, private_::device_dispatch const& dispatch, std::span< VkFence const > fences,
+                                       unsigned long long timeout ) noexcept;
+
+    [[nodiscard]] mode wait_mode() const noexcept { return mode_; }
+    // how long the next wait spins before it blocks
+    [[nodiscard]] std::chrono::nanoseconds spin_budget() const noexcept;
+
+private:
+    mode mode_;
+    std::chrono::nanoseconds max_spin_;
+    // moving average of how long the waits took, in nanoseconds, shared by every thread waiting with the policy
+    std::atomic< int64_t > average_wait_;
+
+    void observe( std::chrono::nanoseconds elapsed ) noexcept;
+};
+
+// A point of GPU progress that resources are held back until: a fence, or a value of a timeline semaphore. A lost
+// device has nothing left executing, so every point counts as passed then; an empty point has always passed.
+struct retirement_point
+{
+    VkFence fence{ VK_NULL_HANDLE };
+    VkSemaphore timeline{ VK_NULL_HANDLE };
+    uint64_t value{ 0 };
+
+    [[nodiscard]] bool empty() const noexcept { return VK_NULL_HANDLE == fence && VK_NULL_HANDLE == timeline; }
+
+    // VK_SUCCESS once passed, VK_TIMEOUT while timeout nanoseconds were not enough, any other error as it came
+    [[nodiscard]] VkResult status( device_reference device, uint64_t timeout ) const noexcept;
+    // waits up to timeout nanoseconds, throws on errors other than running out of time
+    [[nodiscard]] bool passed( device_reference device, uint64_t timeout = 0 ) const;
+
+    friend bool operator==( retirement_point const&, retirement_point const& ) noexcept = default;
+};
+
+// For owners of retired resources going away: a point that was never submitted would never pass, so rather than wait
+// on the points one by one the device is waited for once when any of them is still outstanding. No other thread may
+// be using a queue of the device by then.
+template< typename range_type, typename projection_type = std::identity >
+void wait_until_passed( device_reference const device, range_type const& points, projection_type projection = {} ) noexcept
+{
+    auto const outstanding = std::ranges::any_of(
+        points, [ device ]( retirement_point const& ip ) { return VK_TIMEOUT == ip.status( device, 0 ); }, std::move( projection ) );
+    if( outstanding )
+    {
+        static_cast< void >( device.dispatch().device_wait_idle( device.native() ) );
+    }
+}
+
+} // namespace vkcpp
+
+#endif // _VKCPP_SYNC_INCLUDED_
@@ -0,0 +1,94 @@
+#ifndef _VKCPP_TRACE_INCLUDED_
+#define _VKCPP_TRACE_INCLUDED_
+
+#include <vkcpp/profiler.hpp>
+
+#include <iosfwd>
+#include <mutex>
+#include <string>
+
+namespace vkcpp
+{
+// Records a timeline of the wrapper calls that hand work to the GPU or wait for it (queue submits, fence and semaphore
+// waits, semaphore signals, idle waits) together with the GPU zones of attached profilers, and writes it as Chrome
+// trace JSON or as a Perfetto protobuf trace. Every thread logs its calls into a ring of its own without locking,
+// collect() drains the rings and has to run often enough, once a frame say, for them not to overflow.
+class trace_recorder
+{
+public:
+    // GPU zones are put onto the host clock with VK_EXT_calibrated_timestamps where the device was created with
+    // device_extension::calibrated_timestamps and can calibrate against the host clock the trace reads,
+    // QueryPerformanceCounter on Windows and CLOCK_MONOTONIC elsewhere; without that the first GPU zone is aligned to
+    // the end of the first queue submit, which keeps the order of events but not their exact distance.
+    trace_recorder( device const& device, physical_device physical_device );
+    trace_recorder( trace_recorder& ) = delete;
+    trace_recorder& operator=( trace_recorder& ) = delete;
+    ~trace_recorder();
+
+    // only one recorder records at a time, starting drops whatever an earlier recording left
+    void start();
+    void stop() noexcept;
+    [[nodiscard]] bool recording() const noexcept;
+
+    // the profiler's zones of frames finished while recording go onto the GPU track; the profiler has to outlive the
+    // recorder or be attached to none before
+    void attach( profiler& profiler );
+
+    void collect();
+    // events lost to a full thread ring
+    [[nodiscard]] uint64_t dropped_events() const;
+
+    // both collect first; the JSON loads in chrome://tracing and ui.perfetto.dev, the protobuf in ui.perfetto.dev
+    void write_chrome_json( std::ostream& stream );
+    void write_perfetto( std::ostream& stream );
+
+private:
+    struct cpu_event
+    {
+        char const* name;
+        uint32_t thread;
+        int64_t begin;
+        int64_t end;
+    };
+
+    // in nanoseconds of the device timestamp domain
+    struct gpu_event
+    {
+        std::string name;
+        uint32_t depth;
+        double begin;
+        double end;
+    };
+
+    // a slice of either kind on the host clock, track 0 is the GPU and track thread + 1 a CPU thread
+    struct slice
+    {
+        std::string_view name;
+        uint32_t track;
+        int64_t begin;
+        int64_t end;
+    };
+
+    device_reference device_;
+    double period_;
+    mutable std::mutex mutex_;
+    bool recording_{ false };
+    // the device and host time domains are both calibrateable
+    bool calibratable_;
+    bool calibrated_{ false };
+    // host time minus device time, in nanoseconds
+    double offset_{ 0.0 };
+    uint64_t dropped_{ 0 };
+    uint32_t thread_count_{ 0 };
+    std::vector< cpu_event > cpu_events_;
+    std::vector< gpu_event > gpu_events_;
+    std::vector< profiler* > profilers_;
+
+    void calibrate();
+    void collect_locked();
+    [[nodiscard]] std::vector< slice > slices() const;
+};
+
+} // namespace vkcpp
+
+#endif // _VKCPP_TRACE_INCLUDED_
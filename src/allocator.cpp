@@ -0,0 +1,366 @@
+#include <vkcpp/allocator.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <set>
+
+namespace
+{
+unsigned order_of( VkDeviceSize const size ) noexcept { return static_cast< unsigned >( std::countr_zero( std::bit_ceil( size ) ) ); }
+
+} // namespace
+
+namespace vkcpp
+{
+struct allocator::block
+{
+    device_memory memory;
+    resource_kind kind;
+    bool dedicated;
+    unsigned min_order{ 0 };
+    unsigned max_order{ 0 };
+    void* mapped{ nullptr };
+    size_t allocation_count{ 0 };
+    VkDeviceSize used_bytes{ 0 };
+    VkDeviceSize requested_bytes{ 0 };
+    // free ranges by order, offsets kept sorted so the lowest range is reused first
+    std::vector< std::set< VkDeviceSize > > free_lists;
+
+    block( device_memory&& i_memory, resource_kind const i_kind, bool const i_dedicated )
+        : memory( std::move( i_memory ) )
+        , kind( i_kind )
+        , dedicated( i_dedicated )
+    {
+        if( !dedicated )
+        {
+            min_order = order_of( min_allocation_size );
+            max_order = order_of( memory.size() );
+            free_lists.resize( max_order - min_order + 1 );
+            free_lists.back().insert( 0 );
+        }
+    }
+
+    ~block()
+    {
+        if( nullptr != mapped )
+        {
+            memory.unmap();
+        }
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return 0 == allocation_count; }
+
+    [[nodiscard]] VkDeviceSize largest_free_range() const noexcept
+    {
+        for( auto io = free_lists.size(); 0 < io; --io )
+        {
+            if( !free_lists[ io - 1 ].empty() )
+            {
+                return VkDeviceSize( 1 ) << ( min_order + io - 1 );
+            }
+        }
+        return 0;
+    }
+
+    bool try_allocate( unsigned const order, VkDeviceSize& offset )
+    {
+        if( dedicated || order > max_order )
+        {
+            return false;
+        }
+
+        auto io = std::max( order, min_order ) - min_order;
+        auto const wanted = io;
+        while( io < free_lists.size() && free_lists[ io ].empty() )
+        {
+            ++io;
+        }
+        if( io == free_lists.size() )
+        {
+            return false;
+        }
+
+        offset = *free_lists[ io ].begin();
+        free_lists[ io ].erase( free_lists[ io ].begin() );
+        while( io > wanted )
+        {
+            --io;
+            free_lists[ io ].insert( offset + ( VkDeviceSize( 1 ) << ( min_order + io ) ) );
+        }
+        return true;
+    }
+
+    void release( VkDeviceSize offset, unsigned const order ) noexcept
+    {
+        auto io = order - min_order;
+        while( io + 1 < free_lists.size() )
+        {
+            auto const buddy = offset ^ ( VkDeviceSize( 1 ) << ( min_order + io ) );
+            auto const ibuddy = free_lists[ io ].find( buddy );
+            if( ibuddy == free_lists[ io ].end() )
+            {
+                break;
+            }
+            free_lists[ io ].erase( ibuddy );
+            offset = std::min( offset, buddy );
+            ++io;
+        }
+        free_lists[ io ].insert( offset );
+    }
+};
+
+struct allocator::pool
+{
+    unsigned memory_type_index;
+    resource_kind kind;
+    std::vector< std::unique_ptr< block > > blocks;
+};
+
+allocator::allocation::allocation( allocation&& handle ) noexcept
+    : pallocator_( handle.pallocator_ )
+    , pblock_( handle.pblock_ )
+    , offset_( handle.offset_ )
+    , size_( handle.size_ )
+    , order_( handle.order_ )
+{
+    handle.pallocator_ = nullptr;
+    handle.pblock_ = nullptr;
+}
+
+allocator::allocation& allocator::allocation::operator=( allocation&& handle ) noexcept
+{
+    if( this != &handle )
+    {
+        reset();
+        std::swap( pallocator_, handle.pallocator_ );
+        std::swap( pblock_, handle.pblock_ );
+        offset_ = handle.offset_;
+        size_ = handle.size_;
+        order_ = handle.order_;
+    }
+    return *this;
+}
+
+void allocator::allocation::reset() noexcept
+{
+    if( *this )
+    {
+        pallocator_->release( pblock_, offset_, size_, order_ );
+        pallocator_ = nullptr;
+        pblock_ = nullptr;
+    }
+}
+
+VkDeviceMemory allocator::allocation::native() const noexcept
+{
+    assert( *this );
+    return pblock_->memory.native();
+}
+
+unsigned allocator::allocation::memory_type_index() const noexcept
+{
+    assert( *this );
+    return pblock_->memory.memory_type_index();
+}
+
+bool allocator::allocation::dedicated() const noexcept
+{
+    assert( *this );
+    return pblock_->dedicated;
+}
+
+void* allocator::allocation::map()
+{
+    assert( *this );
+    return static_cast< char* >( pallocator_->map( pblock_ ) ) + offset_;
+}
+
+allocator::allocator( device const& device, physical_device const physical_device, VkDeviceSize const block_size )
+    : device_( device )
+    , memory_property_( physical_device )
+    , block_size_( 0 < block_size ? std::bit_floor( std::max( block_size, min_allocation_size ) ) : 0 )
+    , separate_kinds_( 1 < physical_device::property( physical_device ).limits.bufferImageGranularity )
+{}
+
+allocator::~allocator() = default;
+
+unsigned allocator::select_memory_type( VkMemoryRequirements const& requirements, physical_device::memory_property::flags const memory_flags ) const
+{
+    auto const memory_type_index = memory_property_.find_memory_type_index( requirements.memoryTypeBits, memory_flags );
+    if( memory_type_index < memory_property_.memoryTypeCount )
+    {
+        return memory_type_index;
+    }
+    throw exception( result::ERROR_FEATURE_NOT_PRESENT, dbg::object::DEVICE_MEMORY, "memory type selection" );
+}
+
+VkDeviceSize allocator::block_size_of( unsigned const memory_type_index ) const noexcept
+{
+    if( 0 < block_size_ )
+    {
+        return block_size_;
+    }
+    auto const heap_size = memory_property_.memoryHeaps[ memory_property_.memoryTypes[ memory_type_index ].heapIndex ].size;
+    return std::clamp( std::bit_floor( heap_size / 8 ), min_allocation_size, max_block_size );
+}
+
+allocator::pool& allocator::pool_of( unsigned const memory_type_index, resource_kind const kind )
+{
+    auto const pool_kind = separate_kinds_ ? kind : resource_kind::LINEAR;
+    for( auto& ip: pools_ )
+    {
+        if( ip->memory_type_index == memory_type_index && ip->kind == pool_kind )
+        {
+            return *ip;
+        }
+    }
+    pools_.push_back( std::make_unique< pool >( pool{ memory_type_index, pool_kind, {} } ) );
+    return *pools_.back();
+}
+
+allocator::allocation allocator::allocate( VkMemoryRequirements const& requirements, physical_device::memory_property::flags const memory_flags,
+                                           resource_kind const kind, create_flags const flags )
+{
+    auto const memory_type_index = select_memory_type( requirements, memory_flags );
+    auto const block_size = block_size_of( memory_type_index );
+    // buddy ranges are aligned to their own size, so rounding up to the alignment satisfies it
+    auto const order = order_of( std::max( { requirements.size, requirements.alignment, min_allocation_size } ) );
+
+    if( ( flags & create_flag::DEDICATED )() || ( VkDeviceSize( 1 ) << order ) > block_size / 2 )
+    {
+        return allocate_dedicated_impl( requirements, memory_type_index, nullptr );
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto& target = pool_of( memory_type_index, kind );
+    VkDeviceSize offset = 0;
+    block* pblock = nullptr;
+    for( auto& ib: target.blocks )
+    {
+        if( ib->try_allocate( order, offset ) )
+        {
+            pblock = ib.get();
+            break;
+        }
+    }
+    if( nullptr == pblock )
+    {
+        target.blocks.push_back( std::make_unique< block >( device_memory( device_, block_size, memory_type_index ), target.kind, false ) );
+        pblock = target.blocks.back().get();
+        [[maybe_unused]] auto const allocated = pblock->try_allocate( order, offset );
+        assert( allocated );
+    }
+
+    ++pblock->allocation_count;
+    pblock->used_bytes += VkDeviceSize( 1 ) << order;
+    pblock->requested_bytes += requirements.size;
+    return allocation( this, pblock, offset, requirements.size, order );
+}
+
+allocator::allocation allocator::allocate_dedicated( VkMemoryRequirements const& requirements, physical_device::memory_property::flags const memory_flags,
+                                                     VkBuffer const buffer, VkImage const image )
+{
+    VkMemoryDedicatedAllocateInfo dedicated_info{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO, .pNext = nullptr, .image = image, .buffer = buffer };
+    return allocate_dedicated_impl( requirements, select_memory_type( requirements, memory_flags ), &dedicated_info );
+}
+
+allocator::allocation allocator::allocate_dedicated_impl( VkMemoryRequirements const& requirements, unsigned const memory_type_index,
+                                                          void const* const pnext )
+{
+    auto memory = device_memory( device_, requirements.size, memory_type_index, pnext );
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto& target = pool_of( memory_type_index, resource_kind::LINEAR );
+    target.blocks.push_back( std::make_unique< block >( std::move( memory ), resource_kind::LINEAR, true ) );
+    auto* pblock = target.blocks.back().get();
+    pblock->allocation_count = 1;
+    pblock->used_bytes = requirements.size;
+    pblock->requested_bytes = requirements.size;
+    return allocation( this, pblock, 0, requirements.size, 0 );
+}
+
+void allocator::release( block* const pblock, VkDeviceSize const offset, VkDeviceSize const size, unsigned const order ) noexcept
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    --pblock->allocation_count;
+    if( !pblock->dedicated )
+    {
+        pblock->release( offset, order );
+        pblock->used_bytes -= VkDeviceSize( 1 ) << order;
+        pblock->requested_bytes -= size;
+    }
+
+    if( !pblock->empty() )
+    {
+        return;
+    }
+
+    // dedicated memory goes back right away, sub-allocated blocks only once the pool has another block to use
+    auto& target = pool_of( pblock->memory.memory_type_index(), pblock->dedicated ? resource_kind::LINEAR : pblock->kind );
+    auto const shared_count = std::count_if( target.blocks.begin(), target.blocks.end(), []( auto const& ib ) { return !ib->dedicated; } );
+    if( pblock->dedicated || 1 < shared_count )
+    {
+        std::erase_if( target.blocks, [ pblock ]( auto const& ib ) { return ib.get() == pblock; } );
+    }
+}
+
+void* allocator::map( block* const pblock )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if( nullptr == pblock->mapped )
+    {
+        pblock->mapped = pblock->memory.map();
+    }
+    return pblock->mapped;
+}
+
+allocator::statistics allocator::stats() const
+{
+    statistics result;
+    for( unsigned imt = 0; imt < memory_property_.memoryTypeCount; ++imt )
+    {
+        auto const type_stats = stats( imt );
+        result.block_count += type_stats.block_count;
+        result.dedicated_count += type_stats.dedicated_count;
+        result.allocation_count += type_stats.allocation_count;
+        result.reserved_bytes += type_stats.reserved_bytes;
+        result.used_bytes += type_stats.used_bytes;
+        result.requested_bytes += type_stats.requested_bytes;
+        result.free_bytes += type_stats.free_bytes;
+        result.largest_free_range = std::max( result.largest_free_range, type_stats.largest_free_range );
+    }
+    return result;
+}
+
+allocator::statistics allocator::stats( unsigned const memory_type_index ) const
+{
+    statistics result;
+    std::lock_guard< std::mutex > lock( mutex_ );
+    for( auto const& ip: pools_ )
+    {
+        if( ip->memory_type_index != memory_type_index )
+        {
+            continue;
+        }
+        for( auto const& ib: ip->blocks )
+        {
+            result.allocation_count += ib->allocation_count;
+            result.reserved_bytes += ib->memory.size();
+            result.used_bytes += ib->used_bytes;
+            result.requested_bytes += ib->requested_bytes;
+            if( ib->dedicated )
+            {
+                ++result.dedicated_count;
+                continue;
+            }
+            ++result.block_count;
+            result.free_bytes += ib->memory.size() - ib->used_bytes;
+            result.largest_free_range = std::max( result.largest_free_range, ib->largest_free_range() );
+        }
+    }
+    return result;
+}
+
+} // namespace vkcpp
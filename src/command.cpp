@@ -0,0 +1,152 @@
+#include <vkcpp/command.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace
+{
+struct thread_entry
+{
+    uint64_t manager_id;
+    // expires with the manager, whose entries are then dropped by the thread's next first use of any manager
+    std::weak_ptr< void const > manager;
+    void* pthread_pools;
+};
+
+// managers get ids that are never reused, so an entry left behind by a destroyed manager never matches a later one
+// that happens to sit at the same address
+std::atomic< uint64_t > next_manager_id{ 1 };
+thread_local std::vector< thread_entry > thread_entries;
+
+constexpr uint32_t const buffer_growth = 4;
+
+} // namespace
+
+namespace vkcpp
+{
+command_pool_manager::command_pool_manager( device const& device, device::queue::family::id_type const family_index, size_t const frame_count )
+    : device_( device )
+    , family_index_( family_index )
+    , id_( next_manager_id.fetch_add( 1, std::memory_order_relaxed ) )
+    , alive_( std::make_shared< char const >() )
+    , current_( std::max( frame_count, size_t( 1 ) ) - 1 )
+    , guards_( std::max( frame_count, size_t( 1 ) ) )
+{
+    assert( device );
+}
+
+command_pool_manager::~command_pool_manager()
+{
+    // pools may only go away once nothing recorded from them is still executing
+    wait_until_passed( device_, guards_ );
+}
+
+size_t command_pool_manager::begin_frame()
+{
+    auto const next = ( current_.load( std::memory_order_relaxed ) + 1 ) % guards_.size();
+    auto& frame_guard = guards_[ next ];
+    wait( frame_guard );
+    frame_guard = retirement_point();
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    for( auto& it: threads_ )
+    {
+        auto& frame = it->frames[ next ];
+        if( 0 < frame.used[ 0 ] + frame.used[ 1 ] )
+        {
+            frame.pool.reset_buffers();
+            frame.used = { 0, 0 };
+        }
+    }
+    current_.store( next, std::memory_order_release );
+    return next;
+}
+
+void command_pool_manager::end_frame( VkFence const fence )
+{
+    guards_[ current_.load( std::memory_order_relaxed ) ] = retirement_point{ .fence = fence };
+}
+
+void command_pool_manager::end_frame( VkSemaphore const timeline, uint64_t const value )
+{
+    guards_[ current_.load( std::memory_order_relaxed ) ] = retirement_point{ .timeline = timeline, .value = value };
+}
+
+void command_pool_manager::wait( retirement_point const& frame_guard ) const
+{
+    static_cast< void >( frame_guard.passed( device_, std::numeric_limits< uint64_t >::max() ) );
+}
+
+command_pool_manager::thread_pools& command_pool_manager::local()
+{
+    for( auto const& ie: thread_entries )
+    {
+        if( ie.manager_id == id_ )
+        {
+            return *static_cast< thread_pools* >( ie.pthread_pools );
+        }
+    }
+
+    // first use from this thread, the only time the manager lock is taken outside of begin_frame
+    std::erase_if( thread_entries, []( thread_entry const& ie ) { return ie.manager.expired(); } );
+    auto pools = std::make_unique< thread_pools >();
+    pools->frames.reserve( guards_.size() );
+    for( size_t iif = 0; iif < guards_.size(); ++iif )
+    {
+        pools->frames.push_back( frame_pool{ .pool = command_pool( device_, family_index_, command_pool::create_flags( command_pool::create_flag::TRANSIENT ) ) } );
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    threads_.push_back( std::move( pools ) );
+    thread_entries.push_back( thread_entry{ id_, alive_, threads_.back().get() } );
+    return *threads_.back();
+}
+
+command_buffer command_pool_manager::allocate( command_buffer::level const level )
+{
+    auto& frame = local().frames[ current_.load( std::memory_order_acquire ) ];
+    auto const il = static_cast< size_t >( level );
+    auto& buffers = frame.buffers[ il ];
+    if( frame.used[ il ] == buffers.size() )
+    {
+        auto more = frame.pool.allocate( std::max( static_cast< uint32_t >( buffers.size() ), buffer_growth ), level );
+        buffers.insert( buffers.end(), more.begin(), more.end() );
+    }
+    return buffers[ frame.used[ il ]++ ];
+}
+
+size_t command_pool_manager::thread_count() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return threads_.size();
+}
+
+parallel_recorder::parallel_recorder( command_pool_manager& pools, task_scheduler& scheduler )
+    : pools_( pools )
+    , scheduler_( scheduler )
+{}
+
+void parallel_recorder::record( command_buffer const& primary, size_t const chunk_count, record_type const& record,
+                                VkCommandBufferInheritanceInfo const* const inheritance )
+{
+    VkCommandBufferInheritanceInfo const empty_inheritance{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+    auto usage = command_buffer::usage_flags( command_buffer::usage_flag::ONE_TIME_SUBMIT );
+    if( nullptr != inheritance && VK_NULL_HANDLE != inheritance->renderPass )
+    {
+        usage |= command_buffer::usage_flags( command_buffer::usage_flag::RENDER_PASS_CONTINUE );
+    }
+    auto const* const pinheritance = nullptr != inheritance ? inheritance : &empty_inheritance;
+
+    secondaries_.resize( chunk_count );
+    scheduler_.parallel_for( chunk_count, [ & ]( size_t const chunk ) {
+        auto const secondary = pools_.allocate( command_buffer::level::SECONDARY );
+        secondary.begin( usage, pinheritance );
+        record( secondary, chunk );
+        secondary.end();
+        secondaries_[ chunk ] = secondary.native();
+    } );
+    primary.execute( secondaries_ );
+}
+
+} // namespace vkcpp
@@ -0,0 +1,160 @@
+#include <vkcpp/coroutine.hpp>
+
+#include <cassert>
+
+namespace vkcpp
+{
+bool reactor::awaiter::await_ready() noexcept
+{
+    status_ = preactor_->status_of( { fence_, semaphore_, value_, nullptr, nullptr } );
+    return VK_NOT_READY != status_;
+}
+
+reactor::reactor( device const& device, executor_type executor, std::chrono::nanoseconds const poll_interval )
+    : device_( device.native() )
+    , pdispatch_( device.pdispatch() )
+    , executor_( std::move( executor ) )
+    , poll_interval_( poll_interval )
+    , thread_( [ this ]( std::stop_token const& stop ) { run( stop ); } )
+{
+    assert( device );
+}
+
+reactor::~reactor()
+{
+    thread_.request_stop();
+    thread_.join();
+}
+
+VkResult reactor::status_of( watch_entry const& entry ) const noexcept
+{
+    if( VK_NULL_HANDLE != entry.fence )
+    {
+        return pdispatch_->get_fence_status( device_, entry.fence );
+    }
+
+    uint64_t value = 0;
+    auto status = pdispatch_->get_semaphore_counter_value( device_, entry.semaphore, &value );
+    if( VK_SUCCESS == status && value < entry.value )
+    {
+        return VK_NOT_READY;
+    }
+    return status;
+}
+
+bool reactor::watch( watch_entry const& entry )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if( stopped_ )
+        {
+            *entry.pstatus = VK_NOT_READY;
+            return false;
+        }
+        ++outstanding_;
+        incoming_.push_back( entry );
+    }
+    condition_.notify_one();
+    return true;
+}
+
+void reactor::resume( std::coroutine_handle<> const handle )
+{
+    --outstanding_;
+    if( executor_ )
+    {
+        executor_( handle );
+        return;
+    }
+    handle.resume();
+}
+
+void reactor::run( std::stop_token const& stop )
+{
+    std::vector< watch_entry > watching;
+    std::vector< VkFence > fences;
+    std::vector< VkSemaphore > semaphores;
+    std::vector< uint64_t > values;
+    std::vector< std::coroutine_handle<> > completed;
+
+    while( !stop.stop_requested() )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            if( watching.empty() )
+            {
+                condition_.wait( lock, stop, [ this ]() { return !incoming_.empty(); } );
+            }
+            watching.insert( watching.end(), incoming_.begin(), incoming_.end() );
+            incoming_.clear();
+        }
+        if( watching.empty() )
+        {
+            continue;
+        }
+
+        fences.clear();
+        semaphores.clear();
+        values.clear();
+        for( auto const& iw: watching )
+        {
+            if( VK_NULL_HANDLE != iw.fence )
+            {
+                fences.push_back( iw.fence );
+            }
+            else
+            {
+                semaphores.push_back( iw.semaphore );
+                values.push_back( iw.value );
+            }
+        }
+
+        // block in the driver for at most one poll interval so newly watched work is picked up
+        auto const timeout = static_cast< uint64_t >( poll_interval_.count() );
+        if( !fences.empty() )
+        {
+            pdispatch_->wait_for_fences( device_, static_cast< uint32_t >( fences.size() ), fences.data(), VK_FALSE, timeout );
+        }
+        if( !semaphores.empty() )
+        {
+            VkSemaphoreWaitInfo info{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                                      .pNext = nullptr,
+                                      .flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+                                      .semaphoreCount = static_cast< uint32_t >( semaphores.size() ),
+                                      .pSemaphores = semaphores.data(),
+                                      .pValues = values.data() };
+            pdispatch_->wait_semaphores( device_, &info, fences.empty() ? timeout : 0 );
+        }
+
+        std::erase_if( watching, [ this, &completed ]( watch_entry const& entry ) {
+            auto const status = status_of( entry );
+            if( VK_NOT_READY == status )
+            {
+                return false;
+            }
+            *entry.pstatus = status;
+            completed.push_back( entry.handle );
+            return true;
+        } );
+        for( auto const handle: completed )
+        {
+            resume( handle );
+        }
+        completed.clear();
+    }
+
+    // whatever is still outstanding will never be observed, hand it back as not ready
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        stopped_ = true;
+        watching.insert( watching.end(), incoming_.begin(), incoming_.end() );
+        incoming_.clear();
+    }
+    for( auto const& iw: watching )
+    {
+        *iw.pstatus = VK_NOT_READY;
+        resume( iw.handle );
+    }
+}
+
+} // namespace vkcpp
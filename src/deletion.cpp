@@ -0,0 +1,75 @@
+#include <vkcpp/deletion.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace vkcpp
+{
+deletion_queue::deletion_queue( device const& device )
+    : device_( device )
+{
+    assert( device );
+}
+
+deletion_queue::~deletion_queue()
+{
+    wait_until_passed( device_, batches_, &batch::at );
+    batches_.clear();
+}
+
+void deletion_queue::retire_impl( retirement_point const& at, std::unique_ptr< retired_base > object )
+{
+    assert( !at.empty() );
+    std::lock_guard< std::mutex > lock( mutex_ );
+    // objects retired against the same point share one check
+    if( batches_.empty() || !( batches_.back().at == at ) )
+    {
+        batches_.push_back( batch{ at, {} } );
+    }
+    batches_.back().objects.push_back( std::move( object ) );
+    ++pending_count_;
+}
+
+size_t deletion_queue::collect()
+{
+    std::vector< batch > finished;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        try
+        {
+            // points on different queues pass out of order, so every batch is checked rather than only the oldest
+            for( auto& ib: batches_ )
+            {
+                if( ib.at.passed( device_ ) )
+                {
+                    pending_count_ -= ib.objects.size();
+                    finished.push_back( std::move( ib ) );
+                }
+            }
+        }
+        catch( exception const& )
+        {
+            // what already passed is still destroyed, on the way out through finished
+            std::erase_if( batches_, []( batch const& ib ) { return ib.objects.empty(); } );
+            throw;
+        }
+        std::erase_if( batches_, []( batch const& ib ) { return ib.objects.empty(); } );
+    }
+
+    // the destroy calls run outside the lock, so threads retiring meanwhile never wait on them
+    size_t count = 0;
+    for( auto& ib: finished )
+    {
+        count += ib.objects.size();
+        ib.objects.clear();
+    }
+    return count;
+}
+
+size_t deletion_queue::pending() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return pending_count_;
+}
+
+} // namespace vkcpp
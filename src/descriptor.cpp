@@ -0,0 +1,234 @@
+#include <vkcpp/descriptor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace
+{
+// ids are never reused, so a thread can not mistake a new allocator at the address of a destroyed one for it
+std::atomic< uint64_t > next_allocator_id{ 1 };
+
+struct last_chain
+{
+    uint64_t allocator_id{ 0 };
+    uint64_t generation{ 0 };
+    void* pchain{ nullptr };
+};
+
+// a recording thread nearly always talks to the same allocator, so its chain is found without any lock
+thread_local last_chain this_thread_chain;
+
+bool full( vkcpp::result const status ) noexcept { return vkcpp::result::ERROR_OUT_OF_POOL_MEMORY == status || vkcpp::result::ERROR_FRAGMENTED_POOL == status; }
+
+} // namespace
+
+namespace vkcpp
+{
+descriptor_allocator::descriptor_allocator( device const& device, std::span< VkDescriptorPoolSize const > const sizes_per_set, uint32_t const initial_sets )
+    : device_( device )
+    , sizes_per_set_( sizes_per_set.begin(), sizes_per_set.end() )
+    , id_( next_allocator_id.fetch_add( 1, std::memory_order_relaxed ) )
+    , next_sets_( std::clamp( initial_sets, 1U, max_sets_per_pool ) )
+{
+    assert( device );
+    assert( !sizes_per_set_.empty() );
+}
+
+descriptor_allocator::~descriptor_allocator()
+{
+    wait_until_passed( device_, batches_, &batch::at );
+    batches_.clear();
+}
+
+descriptor_allocator::chain& descriptor_allocator::chain_of_this_thread()
+{
+    if( this_thread_chain.allocator_id == id_ && this_thread_chain.generation == generation_.load( std::memory_order_acquire ) )
+    {
+        return *static_cast< chain* >( this_thread_chain.pchain );
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto& pchain = assigned_[ std::this_thread::get_id() ];
+    if( nullptr == pchain )
+    {
+        // chains are never destroyed before the allocator, so a thread still holding one from an earlier generation
+        // merely shares it with the thread it went to next
+        if( assigned_.size() > chains_.size() )
+        {
+            chains_.push_back( std::make_unique< chain >() );
+        }
+        pchain = chains_[ assigned_.size() - 1 ].get();
+    }
+    this_thread_chain = last_chain{ id_, generation_.load( std::memory_order_relaxed ), pchain };
+    return *pchain;
+}
+
+descriptor_pool descriptor_allocator::acquire_pool( bool& created )
+{
+    // only a chain running out gets here, so checking the retired pools now costs nothing on the common path
+    collect();
+
+    uint32_t sets = 0;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if( !free_.empty() )
+        {
+            auto pool = std::move( free_.back() );
+            free_.pop_back();
+            return pool;
+        }
+        sets = next_sets_;
+        next_sets_ = std::min( 2 * next_sets_, max_sets_per_pool );
+    }
+
+    std::vector< VkDescriptorPoolSize > sizes( sizes_per_set_ );
+    for( auto& is: sizes )
+    {
+        is.descriptorCount *= sets;
+    }
+    created = true;
+    return descriptor_pool( device_, sets, sizes );
+}
+
+VkDescriptorSet descriptor_allocator::allocate( VkDescriptorSetLayout const layout, void const* const pnext )
+{
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    allocate( std::span< VkDescriptorSetLayout const >( &layout, 1 ), &set, pnext );
+    return set;
+}
+
+void descriptor_allocator::allocate( std::span< VkDescriptorSetLayout const > const layouts, VkDescriptorSet* const sets, void const* const pnext )
+{
+    auto& current = chain_of_this_thread();
+    // only retire() ever takes the lock of another thread's chain, so this one is practically never contended
+    std::unique_lock< std::mutex > lock( current.mutex );
+    if( !current.pools.empty() )
+    {
+        auto const status = current.pools.back().try_allocate( layouts, sets, pnext );
+        if( status )
+        {
+            current.set_count += layouts.size();
+            return;
+        }
+        if( !full( status.status() ) )
+        {
+            status.value();
+        }
+    }
+    lock.unlock();
+
+    // a pool that is full stays in the chain until it is retired, only the last one is allocated from
+    bool created = false;
+    auto pool = acquire_pool( created );
+    auto const status = pool.try_allocate( layouts, sets, pnext );
+    if( !status )
+    {
+        // a recycled pool goes back for the next chain, a new one that could not serve a single allocation is dropped
+        if( !created )
+        {
+            std::lock_guard< std::mutex > pool_lock( mutex_ );
+            free_.push_back( std::move( pool ) );
+        }
+        status.value();
+    }
+    lock.lock();
+    current.pools.push_back( std::move( pool ) );
+    current.set_count += layouts.size();
+    lock.unlock();
+
+    // counted only once it is in a chain, so stats never include a pool that was destroyed right away
+    if( created )
+    {
+        std::lock_guard< std::mutex > pool_lock( mutex_ );
+        ++pool_count_;
+    }
+}
+
+void descriptor_allocator::retire( VkFence const fence ) { retire_impl( retirement_point{ .fence = fence } ); }
+
+void descriptor_allocator::retire( VkSemaphore const timeline, uint64_t const value )
+{
+    retire_impl( retirement_point{ .timeline = timeline, .value = value } );
+}
+
+void descriptor_allocator::retire_impl( retirement_point const& at )
+{
+    assert( !at.empty() );
+    // allocate() never holds its chain lock while taking the allocator lock, so taking them in this order is safe
+    std::lock_guard< std::mutex > lock( mutex_ );
+    batch retired{ at, {} };
+    for( auto const& ic: chains_ )
+    {
+        std::lock_guard< std::mutex > chain_lock( ic->mutex );
+        std::move( ic->pools.begin(), ic->pools.end(), std::back_inserter( retired.pools ) );
+        ic->pools.clear();
+        ic->set_count = 0;
+    }
+    assigned_.clear();
+    generation_.fetch_add( 1, std::memory_order_release );
+    if( !retired.pools.empty() )
+    {
+        batches_.push_back( std::move( retired ) );
+    }
+}
+
+size_t descriptor_allocator::collect()
+{
+    std::vector< descriptor_pool > finished;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        try
+        {
+            // points on different queues pass out of order, so every batch is checked rather than only the oldest
+            for( auto& ib: batches_ )
+            {
+                if( ib.at.passed( device_ ) )
+                {
+                    std::move( ib.pools.begin(), ib.pools.end(), std::back_inserter( finished ) );
+                    ib.pools.clear();
+                }
+            }
+        }
+        catch( exception const& )
+        {
+            // what already passed is destroyed rather than reset, on the way out through finished
+            std::erase_if( batches_, []( batch const& ib ) { return ib.pools.empty(); } );
+            throw;
+        }
+        std::erase_if( batches_, []( batch const& ib ) { return ib.pools.empty(); } );
+    }
+
+    // one reset per pool gives back all of its sets, done outside the lock like any other driver call here
+    for( auto const& ip: finished )
+    {
+        ip.reset();
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    reset_count_ += finished.size();
+    std::move( finished.begin(), finished.end(), std::back_inserter( free_ ) );
+    return finished.size();
+}
+
+descriptor_allocator::statistics descriptor_allocator::stats() const
+{
+    statistics result;
+    std::lock_guard< std::mutex > lock( mutex_ );
+    result.pool_count = pool_count_;
+    result.free_pool_count = free_.size();
+    result.reset_count = reset_count_;
+    for( auto const& ib: batches_ )
+    {
+        result.retired_pool_count += ib.pools.size();
+    }
+    for( auto const& ic: chains_ )
+    {
+        std::lock_guard< std::mutex > chain_lock( ic->mutex );
+        result.active_pool_count += ic->pools.size();
+        result.set_count += ic->set_count;
+    }
+    return result;
+}
+
+} // namespace vkcpp
@@ -1,6 +1,9 @@
 #include <utility>
 #include <vkcpp/elements.hpp>
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <limits>
 
 namespace
 {
@@ -25,12 +28,25 @@ VkDebugReportCallbackCreateInfoEXT debug_creation_info( uint32_t const i_level_f
     return result;
 }
 
+template< typename function_type >
+void load_instance_function( VkInstance const instance, char const* const name, function_type& function ) noexcept
+{
+    function = reinterpret_cast< function_type >( vkGetInstanceProcAddr( instance, name ) );
+}
+
+template< typename function_type >
+void load_device_function( PFN_vkGetDeviceProcAddr const loader, VkDevice const device, char const* const name, function_type& function ) noexcept
+{
+    function = reinterpret_cast< function_type >( loader( device, name ) );
+}
+
 } // namespace
 
 namespace vkcpp
 {
 std::vector< layer > layer::enumerate()
 {
+    private_::call_scope const call( api_call::ENUMERATE_INSTANCE_LAYER_PROPERTIES );
     uint32_t count = 0;
     auto status = vkEnumerateInstanceLayerProperties( &count, nullptr );
     if( VK_SUCCESS == status )
@@ -50,6 +66,7 @@ std::vector< layer > layer::enumerate()
 
 std::vector< extension > extension::enumerate( layer::id_type const layer_id )
 {
+    private_::call_scope const call( api_call::ENUMERATE_INSTANCE_EXTENSION_PROPERTIES );
     uint32_t count = 0;
     auto status = vkEnumerateInstanceExtensionProperties( layer_id, &count, nullptr );
     if( VK_SUCCESS == status )
@@ -68,9 +85,11 @@ std::vector< extension > extension::enumerate( layer::id_type const layer_id )
 }
 
 instance::instance( std::string const& app_name, version app_version, std::string const& engine_name, version engine_version,
-                    std::vector< layer::id_type > const& layers, std::vector< extension::id_type > const& extensions )
+                    std::vector< layer::id_type > const& layers, std::vector< extension::id_type > const& extensions,
+                    VkAllocationCallbacks const* const allocation_callbacks )
     : base_type()
 {
+    private_::call_scope const call( api_call::CREATE_INSTANCE );
     VkApplicationInfo app_info{ .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
                                 .pNext = nullptr,
                                 .pApplicationName = app_name.c_str(),
@@ -88,9 +107,10 @@ instance::instance( std::string const& app_name, version app_version, std::strin
                                       .enabledExtensionCount = static_cast< uint32_t >( extensions.size() ),
                                       .ppEnabledExtensionNames = 0 < create_info.enabledExtensionCount ? extensions.data() : nullptr };
 
-    auto status = vkCreateInstance( &create_info, nullptr, pnative() );
+    auto status = vkCreateInstance( &create_info, allocation_callbacks, pnative() );
     if( VK_SUCCESS == status )
     {
+        bind_dispatch( std::make_unique< private_::instance_dispatch const >( native(), allocation_callbacks ) );
         return;
     }
     throw exception( status, dbg::object::INSTANCE, "creation" );
@@ -98,28 +118,108 @@ instance::instance( std::string const& app_name, version app_version, std::strin
 
 namespace private_
 {
-void __stdcall destroy_debug_report( VkInstance instance, VkDebugReportCallbackEXT report, [[maybe_unused]] VkAllocationCallbacks const* callbacks )
+instance_dispatch::instance_dispatch( VkInstance const instance, VkAllocationCallbacks const* const i_allocation_callbacks ) noexcept
+    : allocation_callbacks( i_allocation_callbacks )
 {
-    auto deleter = reinterpret_cast< PFN_vkDestroyDebugReportCallbackEXT >( vkGetInstanceProcAddr( instance, "vkDestroyDebugReportCallbackEXT" ) );
-    if( nullptr != deleter )
-    {
-        deleter( instance, report, nullptr );
-    }
+    load_instance_function( instance, "vkDestroyInstance", destroy_instance );
+    load_instance_function( instance, "vkEnumeratePhysicalDevices", enumerate_physical_devices );
+    load_instance_function( instance, "vkGetPhysicalDeviceProperties", get_physical_device_properties );
+    load_instance_function( instance, "vkGetPhysicalDeviceFeatures", get_physical_device_features );
+    load_instance_function( instance, "vkGetPhysicalDeviceMemoryProperties", get_physical_device_memory_properties );
+    load_instance_function( instance, "vkGetPhysicalDeviceQueueFamilyProperties", get_physical_device_queue_family_properties );
+    load_instance_function( instance, "vkEnumerateDeviceExtensionProperties", enumerate_device_extension_properties );
+    load_instance_function( instance, "vkCreateDevice", create_device );
+    load_instance_function( instance, "vkGetDeviceProcAddr", get_device_proc_addr );
+    load_instance_function( instance, "vkCreateDebugReportCallbackEXT", create_debug_report_callback );
+    load_instance_function( instance, "vkDestroyDebugReportCallbackEXT", destroy_debug_report_callback );
+    load_instance_function( instance, "vkDebugReportMessageEXT", debug_report_message );
+    load_instance_function( instance, "vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR", enumerate_queue_family_performance_query_counters );
+    load_instance_function( instance, "vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR", get_queue_family_performance_query_passes );
+    load_instance_function( instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT", get_physical_device_calibrateable_time_domains );
+}
+
+device_dispatch::device_dispatch( VkDevice const device, PFN_vkGetDeviceProcAddr const loader, VkAllocationCallbacks const* const i_allocation_callbacks ) noexcept
+    : allocation_callbacks( i_allocation_callbacks )
+{
+    load_device_function( loader, device, "vkDestroyDevice", destroy_device );
+    load_device_function( loader, device, "vkDeviceWaitIdle", device_wait_idle );
+    load_device_function( loader, device, "vkGetDeviceQueue", get_device_queue );
+    load_device_function( loader, device, "vkQueueWaitIdle", queue_wait_idle );
+    load_device_function( loader, device, "vkQueueSubmit", queue_submit );
+    load_device_function( loader, device, "vkCreateSemaphore", create_semaphore );
+    load_device_function( loader, device, "vkDestroySemaphore", destroy_semaphore );
+    load_device_function( loader, device, "vkGetSemaphoreCounterValue", get_semaphore_counter_value );
+    load_device_function( loader, device, "vkWaitSemaphores", wait_semaphores );
+    load_device_function( loader, device, "vkSignalSemaphore", signal_semaphore );
+    load_device_function( loader, device, "vkCreateFence", create_fence );
+    load_device_function( loader, device, "vkDestroyFence", destroy_fence );
+    load_device_function( loader, device, "vkWaitForFences", wait_for_fences );
+    load_device_function( loader, device, "vkResetFences", reset_fences );
+    load_device_function( loader, device, "vkGetFenceStatus", get_fence_status );
+    load_device_function( loader, device, "vkAllocateMemory", allocate_memory );
+    load_device_function( loader, device, "vkFreeMemory", free_memory );
+    load_device_function( loader, device, "vkMapMemory", map_memory );
+    load_device_function( loader, device, "vkUnmapMemory", unmap_memory );
+    load_device_function( loader, device, "vkCreateCommandPool", create_command_pool );
+    load_device_function( loader, device, "vkDestroyCommandPool", destroy_command_pool );
+    load_device_function( loader, device, "vkResetCommandPool", reset_command_pool );
+    load_device_function( loader, device, "vkAllocateCommandBuffers", allocate_command_buffers );
+    load_device_function( loader, device, "vkFreeCommandBuffers", free_command_buffers );
+    load_device_function( loader, device, "vkBeginCommandBuffer", begin_command_buffer );
+    load_device_function( loader, device, "vkEndCommandBuffer", end_command_buffer );
+    load_device_function( loader, device, "vkResetCommandBuffer", reset_command_buffer );
+    load_device_function( loader, device, "vkCmdExecuteCommands", cmd_execute_commands );
+    load_device_function( loader, device, "vkCmdPipelineBarrier", cmd_pipeline_barrier );
+    load_device_function( loader, device, "vkCreatePipelineCache", create_pipeline_cache );
+    load_device_function( loader, device, "vkDestroyPipelineCache", destroy_pipeline_cache );
+    load_device_function( loader, device, "vkGetPipelineCacheData", get_pipeline_cache_data );
+    load_device_function( loader, device, "vkMergePipelineCaches", merge_pipeline_caches );
+    load_device_function( loader, device, "vkCreateGraphicsPipelines", create_graphics_pipelines );
+    load_device_function( loader, device, "vkCreateComputePipelines", create_compute_pipelines );
+    load_device_function( loader, device, "vkDestroyPipeline", destroy_pipeline );
+    load_device_function( loader, device, "vkCreateShaderModule", create_shader_module );
+    load_device_function( loader, device, "vkDestroyShaderModule", destroy_shader_module );
+    load_device_function( loader, device, "vkCreateDescriptorSetLayout", create_descriptor_set_layout );
+    load_device_function( loader, device, "vkDestroyDescriptorSetLayout", destroy_descriptor_set_layout );
+    load_device_function( loader, device, "vkCreatePipelineLayout", create_pipeline_layout );
+    load_device_function( loader, device, "vkDestroyPipelineLayout", destroy_pipeline_layout );
+    load_device_function( loader, device, "vkCreateSampler", create_sampler );
+    load_device_function( loader, device, "vkDestroySampler", destroy_sampler );
+    load_device_function( loader, device, "vkCreateDescriptorPool", create_descriptor_pool );
+    load_device_function( loader, device, "vkDestroyDescriptorPool", destroy_descriptor_pool );
+    load_device_function( loader, device, "vkResetDescriptorPool", reset_descriptor_pool );
+    load_device_function( loader, device, "vkAllocateDescriptorSets", allocate_descriptor_sets );
+    load_device_function( loader, device, "vkCreateDescriptorUpdateTemplate", create_descriptor_update_template );
+    load_device_function( loader, device, "vkDestroyDescriptorUpdateTemplate", destroy_descriptor_update_template );
+    load_device_function( loader, device, "vkUpdateDescriptorSetWithTemplate", update_descriptor_set_with_template );
+    load_device_function( loader, device, "vkCreateQueryPool", create_query_pool );
+    load_device_function( loader, device, "vkDestroyQueryPool", destroy_query_pool );
+    load_device_function( loader, device, "vkGetQueryPoolResults", get_query_pool_results );
+    load_device_function( loader, device, "vkCmdResetQueryPool", cmd_reset_query_pool );
+    load_device_function( loader, device, "vkCmdWriteTimestamp", cmd_write_timestamp );
+    load_device_function( loader, device, "vkCmdBeginQuery", cmd_begin_query );
+    load_device_function( loader, device, "vkCmdEndQuery", cmd_end_query );
+    load_device_function( loader, device, "vkAcquireProfilingLockKHR", acquire_profiling_lock );
+    load_device_function( loader, device, "vkReleaseProfilingLockKHR", release_profiling_lock );
+    load_device_function( loader, device, "vkCmdPushDescriptorSetKHR", cmd_push_descriptor_set );
+    load_device_function( loader, device, "vkCmdPushDescriptorSetWithTemplateKHR", cmd_push_descriptor_set_with_template );
+    load_device_function( loader, device, "vkGetCalibratedTimestampsEXT", get_calibrated_timestamps );
 }
 } // namespace private_
 
 namespace dbg
 {
-report::report( instance const instance, callback_type cb, flags const flags, void* const puser )
-    : base_type( 1, instance.native() )
+report::report( instance const& instance, callback_type cb, flags const flags, void* const puser )
+    : base_type( 1, instance.native(), instance.pdispatch() )
     , mc_report_( std::move( cb ) )
     , puser_data_( puser )
 {
-    auto create = reinterpret_cast< PFN_vkCreateDebugReportCallbackEXT >( vkGetInstanceProcAddr( instance.native(), "vkCreateDebugReportCallbackEXT" ) );
+    private_::call_scope const call( api_call::CREATE_DEBUG_REPORT_CALLBACK );
+    auto create = instance.dispatch().create_debug_report_callback;
     if( nullptr != create )
     {
         auto create_info = debug_creation_info( flags(), this );
-        auto status = create( instance.native(), &create_info, nullptr, pnative() );
+        auto status = create( instance.native(), &create_info, instance.dispatch().allocation_callbacks, pnative() );
         if( VK_SUCCESS == status )
         {
             return;
@@ -130,8 +230,8 @@ report::report( instance const instance, callback_type cb, flags const flags, vo
 
 bool report::operator()( flags const flags, object const object, int const message_code, std::string const& message )
 {
-    auto native_report = reinterpret_cast< PFN_vkDebugReportMessageEXT >( vkGetInstanceProcAddr( source_native(), "vkDebugReportMessageEXT" ) );
-    if( VK_NULL_HANDLE != native_report )
+    auto native_report = dispatch().debug_report_message;
+    if( nullptr != native_report )
     {
         native_report( source_native(), flags(), static_cast< VkDebugReportObjectTypeEXT >( object ), 0LL, 0L, message_code, nullptr, message.c_str() );
         return true;
@@ -149,14 +249,22 @@ bool report::operator()( flag const flag, object const object, unsigned long lon
 
 std::vector< physical_device > physical_device::enumerate( vkcpp::instance const& instance )
 {
+    private_::call_scope const call( api_call::ENUMERATE_PHYSICAL_DEVICES );
+    auto const& dispatch = instance.dispatch();
     uint32_t count = 0;
-    vkEnumeratePhysicalDevices( instance.native(), &count, nullptr );
+    dispatch.enumerate_physical_devices( instance.native(), &count, nullptr );
     if( 0 < count )
     {
-        std::vector< physical_device > device_list( count );
-        auto const status = vkEnumeratePhysicalDevices( instance.native(), &count, reinterpret_cast< VkPhysicalDevice* >( device_list.data() ) );
+        std::vector< VkPhysicalDevice > native_list( count );
+        auto const status = dispatch.enumerate_physical_devices( instance.native(), &count, native_list.data() );
         if( VK_SUCCESS == status )
         {
+            std::vector< physical_device > device_list;
+            device_list.reserve( count );
+            for( uint32_t ipd = 0; ipd < count; ++ipd )
+            {
+                device_list.emplace_back( native_list[ ipd ], &dispatch );
+            }
             return device_list;
         }
     }
@@ -177,56 +285,118 @@ unsigned physical_device::memory_property::find_memory_type_index( unsigned cons
 
 std::vector< extension > device_extension::enumerate( physical_device const device, layer::id_type const layer_id )
 {
+    private_::call_scope const call( api_call::ENUMERATE_DEVICE_EXTENSION_PROPERTIES );
     uint32_t count = 0;
-    auto status = vkEnumerateDeviceExtensionProperties( device.native(), layer_id, &count, nullptr );
+    auto const& dispatch = device.dispatch();
+    auto status = dispatch.enumerate_device_extension_properties( device.native(), layer_id, &count, nullptr );
     if( VK_SUCCESS == status )
     {
         if( 0 < count )
         {
             std::vector< extension > extension_list( count );
-            vkEnumerateDeviceExtensionProperties( device.native(), layer_id, &count, extension_list.data() );
+            dispatch.enumerate_device_extension_properties( device.native(), layer_id, &count, extension_list.data() );
             return extension_list;
         }
     }
     throw exception( status, dbg::object::PHYSICAL_DEVICE, "extension enumeration" );
 }
 
-device::queue::queue( device const device, device::queue::family::id_type const family_index, id_type const index )
+device::queue::queue( device const& device, device::queue::family::id_type const family_index, id_type const index )
+    : pdispatch_( device.pdispatch() )
 {
-    vkGetDeviceQueue( device.native(), family_index, index, &native_ );
+    private_::call_scope const call( api_call::GET_DEVICE_QUEUE );
+    pdispatch_->get_device_queue( device.native(), family_index, index, &native_ );
 }
 
-void device::queue::wait_idle() const
+expected<> device::queue::try_submit( std::span< VkSubmitInfo const > const infos, VkFence const fence ) const noexcept
 {
-    auto status = vkQueueWaitIdle( native_ );
-    if( VK_SUCCESS != status )
-    {
-        throw exception( status, dbg::object::QUEUE, "waiting for idle" );
-    }
+    private_::call_scope const call( api_call::QUEUE_SUBMIT );
+    private_::trace_scope const scope( "vkQueueSubmit" );
+    auto status = pdispatch_->queue_submit( native_, static_cast< uint32_t >( infos.size() ), infos.data(), fence );
+    return private_::check( status, dbg::object::QUEUE, "submission" );
+}
+
+expected<> device::queue::try_wait_idle() const noexcept
+{
+    private_::call_scope const call( api_call::QUEUE_WAIT_IDLE );
+    private_::trace_scope const scope( "vkQueueWaitIdle" );
+    return private_::check( pdispatch_->queue_wait_idle( native_ ), dbg::object::QUEUE, "waiting for idle" );
 }
 
 std::vector< device::queue::family > device::queue::family::enumerate( physical_device const physical_device )
 {
+    private_::call_scope const call( api_call::GET_PHYSICAL_DEVICE_QUEUE_FAMILY_PROPERTIES );
+    auto const& dispatch = physical_device.dispatch();
     uint32_t count = 0;
-    vkGetPhysicalDeviceQueueFamilyProperties( physical_device.native(), &count, nullptr );
+    dispatch.get_physical_device_queue_family_properties( physical_device.native(), &count, nullptr );
     if( 0 < count )
     {
         std::vector< device::queue::family > queue_list( count );
-        vkGetPhysicalDeviceQueueFamilyProperties( physical_device.native(), &count, queue_list.data() );
+        dispatch.get_physical_device_queue_family_properties( physical_device.native(), &count, queue_list.data() );
         return queue_list;
     }
     return std::vector< device::queue::family >();
 }
 
-void device::wait_idle() const
+device::queue::topology::topology( physical_device const physical_device )
 {
-    auto status = vkDeviceWaitIdle( native() );
-    if( VK_SUCCESS != status )
+    auto const family_list = family::enumerate( physical_device );
+    queue_counts_.resize( family_list.size(), 0 );
+
+    constexpr std::array< uint32_t, SPARSE_BINDING + 1 > const required_flag{ VK_QUEUE_GRAPHICS_BIT, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_TRANSFER_BIT,
+                                                                                VK_QUEUE_SPARSE_BINDING_BIT };
+    constexpr uint32_t const scored_flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT;
+
+    for( unsigned ik = 0; ik < required_flag.size(); ++ik )
     {
-        throw exception( status, dbg::object::DEVICE, "waiting for idle" );
+        auto& target = locations_[ ik ];
+        int best_score = std::numeric_limits< int >::max();
+        for( family::id_type iif = 0; iif < family_list.size(); ++iif )
+        {
+            auto const& candidate = family_list[ iif ];
+            auto abilities = candidate.queueFlags & scored_flags;
+            // graphics and compute families take transfers whether they report the bit or not
+            if( 0 != ( abilities & ( VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT ) ) )
+            {
+                abilities |= VK_QUEUE_TRANSFER_BIT;
+            }
+            if( 0 == candidate.queueCount || 0 == ( abilities & required_flag[ ik ] ) )
+            {
+                continue;
+            }
+
+            // fewer extra abilities is more specialised, a family with spare queues wins a tie
+            auto const extra_count = std::popcount( abilities & ~required_flag[ ik ] );
+            auto const spare = queue_counts_[ iif ] < candidate.queueCount ? 0 : 1;
+            auto const score = extra_count * 2 + spare;
+            if( score < best_score )
+            {
+                best_score = score;
+                target.family_index = iif;
+            }
+        }
+
+        if( family::IGNORE_FAMILY != target.family_index )
+        {
+            auto& count = queue_counts_[ target.family_index ];
+            target.index = std::min( count, family_list[ target.family_index ].queueCount - 1 );
+            count = std::max( count, target.index + 1 );
+        }
     }
 }
 
+bool device::queue::topology::dedicated( kind const queue_kind ) const noexcept
+{
+    return has( queue_kind ) && locations_[ queue_kind ].family_index != locations_[ GRAPHICS ].family_index;
+}
+
+expected<> device::try_wait_idle() const noexcept
+{
+    private_::call_scope const call( api_call::DEVICE_WAIT_IDLE );
+    private_::trace_scope const scope( "vkDeviceWaitIdle" );
+    return private_::check( dispatch().device_wait_idle( native() ), dbg::object::DEVICE, "waiting for idle" );
+}
+
 device::builder& device::builder::reserve_queue_family( queue::family::id_type const family_index, std::vector< queue::priority_type > queue_priority ) &
 {
     queue_priorities_.push_back( std::move( queue_priority ) );
@@ -239,6 +409,32 @@ device::builder& device::builder::reserve_queue_family( queue::family::id_type c
     return *this;
 }
 
+device::queue_set::queue_set( device const& device, queue::topology const& topology )
+    : topology_( topology )
+{
+    for( unsigned ik = 0; ik < queues_.size(); ++ik )
+    {
+        auto const& location = topology_[ static_cast< queue::kind >( ik ) ];
+        if( queue::family::IGNORE_FAMILY != location.family_index )
+        {
+            queues_[ ik ] = queue( device, location.family_index, location.index );
+        }
+    }
+}
+
+device::builder& device::builder::reserve_queues( queue::topology const& topology ) &
+{
+    auto const& queue_counts = topology.queue_counts();
+    for( queue::family::id_type iif = 0; iif < queue_counts.size(); ++iif )
+    {
+        if( 0 < queue_counts[ iif ] )
+        {
+            reserve_queue_family( iif, std::vector< queue::priority_type >( queue_counts[ iif ], 1.0F ) );
+        }
+    }
+    return *this;
+}
+
 device device::builder::build( physical_device const physical_device, physical_device::feature const& feature, std::vector< layer::id_type > const& layers,
                                std::vector< device_extension::id_type > const& extensions )
 {
@@ -252,83 +448,375 @@ device device::builder::build( physical_device const physical_device, physical_d
     create_info.enabledExtensionCount = static_cast< uint32_t >( extensions.size() );
     create_info.ppEnabledExtensionNames = ( 0 < create_info.enabledExtensionCount ? extensions.data() : nullptr );
 
+    if( reserved_queues_.empty() )
+    {
+        reserve_queues( queue::topology( physical_device ) );
+    }
+
     create_info.queueCreateInfoCount = static_cast< uint32_t >( reserved_queues_.size() );
     create_info.pQueueCreateInfos = reserved_queues_.data();
     create_info.pEnabledFeatures = &feature;
+    if( VK_FALSE != features12_.timelineSemaphore )
+    {
+        create_info.pNext = &features12_;
+    }
 
-    VkResult status = vkCreateDevice( physical_device.native(), &create_info, nullptr, pnative() );
+    auto const& instance_dispatch = physical_device.dispatch();
+    auto const* const allocation_callbacks = use_instance_callbacks_ ? instance_dispatch.allocation_callbacks : allocation_callbacks_;
+    private_::call_scope const call( api_call::CREATE_DEVICE );
+    VkResult status = instance_dispatch.create_device( physical_device.native(), &create_info, allocation_callbacks, pnative() );
     if( VK_SUCCESS == status )
     {
+        bind_dispatch( std::make_unique< private_::device_dispatch const >( native(), instance_dispatch.get_device_proc_addr, allocation_callbacks ) );
         return device( std::move( *this ) );
     }
     throw exception( status, dbg::object::DEVICE, "creation" );
 }
 
-template< derived_handle_kind handle_kind >
-semaphore< handle_kind >::semaphore( device const device, size_t const size )
-    : base_type( size, device.native() )
+device_memory::device_memory( device_reference const device, VkDeviceSize const size, unsigned const memory_type_index, void const* const pnext )
+    : base_type( 1, device.native(), device.pdispatch() )
+    , size_( size )
+    , memory_type_index_( memory_type_index )
 {
-    if( device )
+    private_::call_scope const call( api_call::ALLOCATE_MEMORY );
+    VkMemoryAllocateInfo info{ .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, .pNext = pnext, .allocationSize = size, .memoryTypeIndex = memory_type_index };
+
+    auto status = dispatch().allocate_memory( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
     {
-        VkSemaphoreCreateInfo info{};
-        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        info.flags = 0;
-        info.pNext = nullptr;
-        for( size_t is = 0; is < size; ++is )
-        {
-            auto status = vkCreateSemaphore( device.native(), &info, nullptr, base_type::pnative( is ) );
-            if( VK_SUCCESS != status )
-            {
-                throw exception( status, dbg::object::SEMAPHORE, "creation" );
-            }
-        }
+        throw exception( status, dbg::object::DEVICE_MEMORY, "allocation" );
+    }
+}
+
+void* device_memory::map( VkDeviceSize const offset, VkDeviceSize const size )
+{
+    assert( *this );
+    private_::call_scope const call( api_call::MAP_MEMORY );
+    void* result = nullptr;
+    auto status = dispatch().map_memory( source_native(), native(), offset, size, 0, &result );
+    if( VK_SUCCESS == status )
+    {
+        return result;
+    }
+    throw exception( status, dbg::object::DEVICE_MEMORY, "mapping" );
+}
+
+void device_memory::unmap() noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::UNMAP_MEMORY );
+    dispatch().unmap_memory( source_native(), native() );
+}
+
+expected<> command_buffer::try_begin( usage_flags const flags, VkCommandBufferInheritanceInfo const* const inheritance ) const noexcept
+{
+    private_::call_scope const call( api_call::BEGIN_COMMAND_BUFFER );
+    VkCommandBufferBeginInfo info{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                   .pNext = nullptr,
+                                   .flags = static_cast< VkCommandBufferUsageFlags >( flags() ),
+                                   .pInheritanceInfo = inheritance };
+    return private_::check( dispatch().begin_command_buffer( native_, &info ), dbg::object::COMMAND_BUFFER, "beginning" );
+}
+
+expected<> command_buffer::try_end() const noexcept
+{
+    private_::call_scope const call( api_call::END_COMMAND_BUFFER );
+    return private_::check( dispatch().end_command_buffer( native_ ), dbg::object::COMMAND_BUFFER, "ending" );
+}
+
+expected<> command_buffer::try_reset( bool const release_resources ) const noexcept
+{
+    private_::call_scope const call( api_call::RESET_COMMAND_BUFFER );
+    auto status = dispatch().reset_command_buffer( native_, release_resources ? VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT : 0 );
+    return private_::check( status, dbg::object::COMMAND_BUFFER, "reset" );
+}
+
+command_pool::command_pool( device_reference const device, device::queue::family::id_type const family_index, create_flags const flags )
+    : base_type( 1, device.native(), device.pdispatch() )
+    , family_index_( family_index )
+{
+    private_::call_scope const call( api_call::CREATE_COMMAND_POOL );
+    VkCommandPoolCreateInfo info{ .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                                  .pNext = nullptr,
+                                  .flags = static_cast< VkCommandPoolCreateFlags >( flags() ),
+                                  .queueFamilyIndex = family_index };
+
+    auto status = dispatch().create_command_pool( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::COMMAND_POOL, "creation" );
+    }
+}
+
+std::vector< command_buffer > command_pool::allocate( uint32_t const count, command_buffer::level const level ) const
+{
+    assert( *this );
+    private_::call_scope const call( api_call::ALLOCATE_COMMAND_BUFFERS );
+    VkCommandBufferAllocateInfo info{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                      .pNext = nullptr,
+                                      .commandPool = native(),
+                                      .level = static_cast< VkCommandBufferLevel >( level ),
+                                      .commandBufferCount = count };
+    std::vector< VkCommandBuffer > native_list( count );
+    auto status = dispatch().allocate_command_buffers( source_native(), &info, native_list.data() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::COMMAND_BUFFER, "allocation" );
     }
+
+    std::vector< command_buffer > result;
+    result.reserve( count );
+    for( auto const in: native_list )
+    {
+        result.emplace_back( in, &dispatch() );
+    }
+    return result;
 }
 
-template< derived_handle_kind handle_kind >
-fence< handle_kind >::fence( device const device, size_t const size, create_flags const flags )
-    : base_type( size, device.native() )
+void command_pool::free_buffers( std::span< command_buffer const > const buffers ) const
 {
-    if( device )
+    assert( *this );
+    private_::call_scope const call( api_call::FREE_COMMAND_BUFFERS );
+    std::vector< VkCommandBuffer > native_list;
+    native_list.reserve( buffers.size() );
+    for( auto const& ib: buffers )
     {
-        VkFenceCreateInfo info{};
+        native_list.push_back( ib.native() );
+    }
+    dispatch().free_command_buffers( source_native(), native(), static_cast< uint32_t >( native_list.size() ), native_list.data() );
+}
+
+expected<> command_pool::try_reset_buffers( bool const release_resources ) const noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::RESET_COMMAND_POOL );
+    auto status = dispatch().reset_command_pool( source_native(), native(), release_resources ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0 );
+    return private_::check( status, dbg::object::COMMAND_POOL, "reset" );
+}
 
-        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        info.pNext = nullptr;
-        info.flags = flags;
-        for( size_t iif = 0; iif < size; ++iif )
+pipeline_cache::pipeline_cache( device_reference const device, std::span< std::byte const > const initial_data )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_PIPELINE_CACHE );
+    VkPipelineCacheCreateInfo info{ .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+                                    .pNext = nullptr,
+                                    .flags = 0,
+                                    .initialDataSize = initial_data.size(),
+                                    .pInitialData = initial_data.data() };
+
+    auto status = dispatch().create_pipeline_cache( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE_CACHE, "creation" );
+    }
+}
+
+std::vector< std::byte > pipeline_cache::data() const
+{
+    assert( *this );
+    private_::call_scope const call( api_call::GET_PIPELINE_CACHE_DATA );
+    std::vector< std::byte > result;
+    VkResult status = VK_INCOMPLETE;
+    // the cache can grow between the size query and the copy while other threads compile
+    while( VK_INCOMPLETE == status )
+    {
+        size_t size = 0;
+        status = dispatch().get_pipeline_cache_data( source_native(), native(), &size, nullptr );
+        if( VK_SUCCESS == status )
         {
-            auto status = vkCreateFence( device, &info, nullptr, base_type::pnative( iif ) );
-            if( VK_SUCCESS != status )
-            {
-                throw vkcpp::exception( status, vkcpp::dbg::object::FENCE, "creation" );
-            }
+            result.resize( size );
+            status = dispatch().get_pipeline_cache_data( source_native(), native(), &size, result.data() );
+            result.resize( size );
         }
     }
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE_CACHE, "data query" );
+    }
+    return result;
 }
 
-template< derived_handle_kind handle_kind >
-void fence< handle_kind >::wait( unsigned long long const timeout )
+void pipeline_cache::merge( std::span< VkPipelineCache const > const sources ) const
 {
     assert( *this );
-    auto status = vkWaitForFences( this->source_native_, base_type::size(), base_type::pnative( 0 ), VK_TRUE, timeout );
-    if( VK_SUCCESS == status )
+    private_::call_scope const call( api_call::MERGE_PIPELINE_CACHES );
+    if( sources.empty() )
     {
         return;
     }
-    throw exception( status, dbg::object::FENCE, "waiting" );
+    auto status = dispatch().merge_pipeline_caches( source_native(), native(), static_cast< uint32_t >( sources.size() ), sources.data() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE_CACHE, "merge" );
+    }
 }
 
-template< derived_handle_kind handle_kind >
-void fence< handle_kind >::reset_signal()
+pipeline::pipeline( device_reference const device, VkComputePipelineCreateInfo const& info, VkPipelineCache const cache )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_COMPUTE_PIPELINES );
+    auto status = dispatch().create_compute_pipelines( device.native(), cache, 1, &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE, "compute creation" );
+    }
+}
+
+pipeline::pipeline( device_reference const device, VkGraphicsPipelineCreateInfo const& info, VkPipelineCache const cache )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_GRAPHICS_PIPELINES );
+    auto status = dispatch().create_graphics_pipelines( device.native(), cache, 1, &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE, "graphics creation" );
+    }
+}
+
+shader_module::shader_module( device_reference const device, VkShaderModuleCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_SHADER_MODULE );
+    auto status = dispatch().create_shader_module( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::SHADER_MODULE, "creation" );
+    }
+}
+
+shader_module::shader_module( device_reference const device, std::span< uint32_t const > const code )
+    : shader_module( device,
+                     VkShaderModuleCreateInfo{ .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+                                               .pNext = nullptr,
+                                               .flags = 0,
+                                               .codeSize = code.size_bytes(),
+                                               .pCode = code.data() } )
+{}
+
+descriptor_set_layout::descriptor_set_layout( device_reference const device, VkDescriptorSetLayoutCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_DESCRIPTOR_SET_LAYOUT );
+    auto status = dispatch().create_descriptor_set_layout( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::DESCRIPTOR_SET_LAYOUT, "creation" );
+    }
+}
+
+pipeline_layout::pipeline_layout( device_reference const device, VkPipelineLayoutCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_PIPELINE_LAYOUT );
+    auto status = dispatch().create_pipeline_layout( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::PIPELINE_LAYOUT, "creation" );
+    }
+}
+
+sampler::sampler( device_reference const device, VkSamplerCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_SAMPLER );
+    auto status = dispatch().create_sampler( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::SAMPLER, "creation" );
+    }
+}
+
+descriptor_pool::descriptor_pool( device_reference const device, VkDescriptorPoolCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_DESCRIPTOR_POOL );
+    auto status = dispatch().create_descriptor_pool( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::DESCRIPTOR_POOL, "creation" );
+    }
+}
+
+descriptor_pool::descriptor_pool( device_reference const device, uint32_t const max_sets, std::span< VkDescriptorPoolSize const > const sizes )
+    : descriptor_pool( device,
+                       VkDescriptorPoolCreateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                                                   .pNext = nullptr,
+                                                   .flags = 0,
+                                                   .maxSets = max_sets,
+                                                   .poolSizeCount = static_cast< uint32_t >( sizes.size() ),
+                                                   .pPoolSizes = sizes.data() } )
+{}
+
+std::vector< VkDescriptorSet > descriptor_pool::allocate( std::span< VkDescriptorSetLayout const > const layouts, void const* const pnext ) const
+{
+    std::vector< VkDescriptorSet > result( layouts.size() );
+    try_allocate( layouts, result.data(), pnext ).value();
+    return result;
+}
+
+expected<> descriptor_pool::try_allocate( std::span< VkDescriptorSetLayout const > const layouts, VkDescriptorSet* const sets,
+                                          void const* const pnext ) const noexcept
 {
     assert( *this );
-    auto status = vkResetFences( this->source_native_, base_type::size(), base_type::pnative( 0 ) );
-    if( VK_SUCCESS == status )
+    private_::call_scope const call( api_call::ALLOCATE_DESCRIPTOR_SETS );
+    VkDescriptorSetAllocateInfo info{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                                      .pNext = pnext,
+                                      .descriptorPool = native(),
+                                      .descriptorSetCount = static_cast< uint32_t >( layouts.size() ),
+                                      .pSetLayouts = layouts.data() };
+    auto status = dispatch().allocate_descriptor_sets( source_native(), &info, sets );
+    return private_::check( status, dbg::object::DESCRIPTOR_SET, "allocation" );
+}
+
+expected<> descriptor_pool::try_reset() const noexcept
+{
+    assert( *this );
+    private_::call_scope const call( api_call::RESET_DESCRIPTOR_POOL );
+    auto status = dispatch().reset_descriptor_pool( source_native(), native(), 0 );
+    return private_::check( status, dbg::object::DESCRIPTOR_POOL, "reset" );
+}
+
+query_pool::query_pool( device const& device, VkQueryPoolCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+    , count_( info.queryCount )
+{
+    private_::call_scope const call( api_call::CREATE_QUERY_POOL );
+    auto status = dispatch().create_query_pool( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
     {
-        return;
+        throw exception( status, dbg::object::QUERY_POOL, "creation" );
+    }
+}
+
+query_pool::query_pool( device const& device, VkQueryType const type, uint32_t const count, VkQueryPipelineStatisticFlags const statistics )
+    : query_pool( device,
+                  VkQueryPoolCreateInfo{ .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                                         .pNext = nullptr,
+                                         .flags = 0,
+                                         .queryType = type,
+                                         .queryCount = count,
+                                         .pipelineStatistics = statistics } )
+{}
+
+expected<> query_pool::try_results( uint32_t const first, uint32_t const count, std::span< std::byte > const data, VkDeviceSize const stride,
+                                    VkQueryResultFlags const flags ) const noexcept
+{
+    assert( *this );
+    assert( first + count <= count_ );
+    private_::call_scope const call( api_call::GET_QUERY_POOL_RESULTS );
+    auto status = dispatch().get_query_pool_results( source_native(), native(), first, count, data.size(), data.data(), stride, flags );
+    return private_::check( status, dbg::object::QUERY_POOL, "results" );
+}
+
+descriptor_update_template::descriptor_update_template( device const& device, VkDescriptorUpdateTemplateCreateInfo const& info )
+    : base_type( 1, device.native(), device.pdispatch() )
+{
+    private_::call_scope const call( api_call::CREATE_DESCRIPTOR_UPDATE_TEMPLATE );
+    auto status = dispatch().create_descriptor_update_template( device.native(), &info, dispatch().allocation_callbacks, base_type::pnative() );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::DESCRIPTOR_UPDATE_TEMPLATE_EXT, "creation" );
     }
-    throw exception( status, dbg::object::FENCE, "reset" );
 }
 
 } // namespace vkcpp
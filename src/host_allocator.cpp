@@ -0,0 +1,328 @@
+#include <vkcpp/host_allocator.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace
+{
+// sits right in front of every block handed to the driver
+struct block_header
+{
+    size_t size;
+    uint32_t offset;
+    uint32_t scope;
+};
+static_assert( sizeof( block_header ) <= 16 );
+
+constexpr size_t const header_alignment = 16;
+
+constexpr size_t align_up( size_t const value, size_t const alignment ) noexcept { return ( value + alignment - 1 ) & ~( alignment - 1 ); }
+
+// std::aligned_alloc is missing from the MSVC runtime, and what _aligned_malloc hands out has to go back to _aligned_free
+void* aligned_allocate( size_t const size, size_t const alignment ) noexcept
+{
+#ifdef _WIN32
+    return _aligned_malloc( size, alignment );
+#else
+    return std::aligned_alloc( alignment, align_up( size, alignment ) );
+#endif
+}
+
+void aligned_release( void* const memory ) noexcept
+{
+#ifdef _WIN32
+    _aligned_free( memory );
+#else
+    std::free( memory );
+#endif
+}
+
+block_header* header_of( void* const memory ) noexcept { return reinterpret_cast< block_header* >( static_cast< char* >( memory ) - sizeof( block_header ) ); }
+
+struct arena_chunk
+{
+    // one reference per live allocation plus one held by the owning thread while the chunk is its current one
+    std::atomic< size_t > live{ 1 };
+    size_t offset{ 0 };
+};
+constexpr size_t const arena_chunk_header = align_up( sizeof( arena_chunk ), 64 );
+
+void drop_reference( arena_chunk* const pchunk ) noexcept
+{
+    if( 1 == pchunk->live.fetch_sub( 1, std::memory_order_acq_rel ) )
+    {
+        pchunk->~arena_chunk();
+        aligned_release( pchunk );
+    }
+}
+
+struct arena_state
+{
+    arena_chunk* pcurrent{ nullptr };
+
+    ~arena_state()
+    {
+        if( nullptr != pcurrent )
+        {
+            drop_reference( pcurrent );
+        }
+    }
+};
+
+thread_local arena_state thread_arena;
+
+} // namespace
+
+namespace vkcpp
+{
+host_allocator::host_allocator()
+    : callbacks_{ .pUserData = this,
+                  .pfnAllocation = &allocate_callback,
+                  .pfnReallocation = &reallocate_callback,
+                  .pfnFree = &free_callback,
+                  .pfnInternalAllocation = nullptr,
+                  .pfnInternalFree = nullptr }
+{}
+
+void host_allocator::counters::add( size_t const size ) noexcept
+{
+    auto const current = bytes.fetch_add( size, std::memory_order_relaxed ) + size;
+    count.fetch_add( 1, std::memory_order_relaxed );
+    total_count.fetch_add( 1, std::memory_order_relaxed );
+    auto peak = peak_bytes.load( std::memory_order_relaxed );
+    while( peak < current && !peak_bytes.compare_exchange_weak( peak, current, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void host_allocator::counters::remove( size_t const size ) noexcept
+{
+    bytes.fetch_sub( size, std::memory_order_relaxed );
+    count.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+host_allocator::statistics host_allocator::counters::snapshot() const noexcept
+{
+    return statistics{ .bytes = bytes.load( std::memory_order_relaxed ),
+                       .count = count.load( std::memory_order_relaxed ),
+                       .peak_bytes = peak_bytes.load( std::memory_order_relaxed ),
+                       .total_count = total_count.load( std::memory_order_relaxed ) };
+}
+
+host_allocator::statistics host_allocator::stats( scope const allocation_scope ) const noexcept
+{
+    return scope_counters_[ static_cast< size_t >( allocation_scope ) ].snapshot();
+}
+
+host_allocator::statistics host_allocator::stats() const noexcept { return total_counters_.snapshot(); }
+
+void* host_allocator::allocate( size_t const size, size_t const alignment, scope const allocation_scope ) noexcept
+{
+    if( 0 == size )
+    {
+        return nullptr;
+    }
+    // the header takes a whole alignment unit so the block handed out keeps the alignment asked for
+    auto const offset = std::max( alignment, header_alignment );
+    auto* const raw = static_cast< char* >( acquire( size + offset, offset, allocation_scope ) );
+    if( nullptr == raw )
+    {
+        return nullptr;
+    }
+
+    auto* const memory = raw + offset;
+    *header_of( memory ) = block_header{ .size = size, .offset = static_cast< uint32_t >( offset ), .scope = static_cast< uint32_t >( allocation_scope ) };
+    scope_counters_[ static_cast< size_t >( allocation_scope ) ].add( size );
+    total_counters_.add( size );
+    return memory;
+}
+
+void* host_allocator::reallocate( void* const original, size_t const size, size_t const alignment, scope const allocation_scope ) noexcept
+{
+    if( nullptr == original )
+    {
+        return allocate( size, alignment, allocation_scope );
+    }
+    if( 0 == size )
+    {
+        free( original );
+        return nullptr;
+    }
+
+    auto* const memory = allocate( size, alignment, allocation_scope );
+    if( nullptr != memory )
+    {
+        std::memcpy( memory, original, std::min( size, header_of( original )->size ) );
+        free( original );
+    }
+    return memory;
+}
+
+void host_allocator::free( void* const memory ) noexcept
+{
+    if( nullptr == memory )
+    {
+        return;
+    }
+    auto const header = *header_of( memory );
+    auto const allocation_scope = static_cast< scope >( header.scope );
+    scope_counters_[ header.scope ].remove( header.size );
+    total_counters_.remove( header.size );
+    release( static_cast< char* >( memory ) - header.offset, header.size + header.offset, header.offset, allocation_scope );
+}
+
+void* VKAPI_CALL host_allocator::allocate_callback( void* const puser_data, size_t const size, size_t const alignment,
+                                                    VkSystemAllocationScope const allocation_scope )
+{
+    return static_cast< host_allocator* >( puser_data )->allocate( size, alignment, static_cast< scope >( allocation_scope ) );
+}
+
+void* VKAPI_CALL host_allocator::reallocate_callback( void* const puser_data, void* const poriginal, size_t const size, size_t const alignment,
+                                                      VkSystemAllocationScope const allocation_scope )
+{
+    return static_cast< host_allocator* >( puser_data )->reallocate( poriginal, size, alignment, static_cast< scope >( allocation_scope ) );
+}
+
+void VKAPI_CALL host_allocator::free_callback( void* const puser_data, void* const pmemory ) { static_cast< host_allocator* >( puser_data )->free( pmemory ); }
+
+void* system_host_allocator::acquire( size_t const size, size_t const alignment, [[maybe_unused]] scope const allocation_scope ) noexcept
+{
+    return aligned_allocate( size, alignment );
+}
+
+void system_host_allocator::release( void* const memory, [[maybe_unused]] size_t const size, [[maybe_unused]] size_t const alignment,
+                                     [[maybe_unused]] scope const allocation_scope ) noexcept
+{
+    aligned_release( memory );
+}
+
+pool_host_allocator::~pool_host_allocator()
+{
+    for( auto* const ic: chunks_ )
+    {
+        aligned_release( ic );
+    }
+}
+
+void* pool_host_allocator::acquire( size_t const size, size_t const alignment, [[maybe_unused]] scope const allocation_scope ) noexcept
+{
+    // blocks are carved at multiples of their size out of chunk aligned memory, so a class is aligned to its size
+    auto const class_size = std::bit_ceil( std::max( { size, alignment, min_class_size } ) );
+    if( class_size > max_class_size )
+    {
+        return aligned_allocate( size, alignment );
+    }
+
+    auto& target = classes_[ std::countr_zero( class_size ) - std::countr_zero( min_class_size ) ];
+    {
+        std::lock_guard< std::mutex > lock( target.mutex );
+        if( nullptr != target.free_list )
+        {
+            auto* const result = target.free_list;
+            target.free_list = result->next;
+            return result;
+        }
+    }
+
+    auto* const chunk = static_cast< char* >( aligned_allocate( chunk_size, chunk_size ) );
+    if( nullptr == chunk )
+    {
+        return nullptr;
+    }
+    {
+        std::lock_guard< std::mutex > lock( chunk_mutex_ );
+        chunks_.push_back( chunk );
+    }
+
+    // the first block goes to the caller, the rest of the chunk onto the free list in address order
+    free_block* head = nullptr;
+    for( auto io = chunk_size; io > class_size; io -= class_size )
+    {
+        auto* const block = reinterpret_cast< free_block* >( chunk + io - class_size );
+        block->next = head;
+        head = block;
+    }
+    std::lock_guard< std::mutex > lock( target.mutex );
+    auto* tail = head;
+    while( nullptr != tail->next )
+    {
+        tail = tail->next;
+    }
+    tail->next = target.free_list;
+    target.free_list = head;
+    return chunk;
+}
+
+void pool_host_allocator::release( void* const memory, size_t const size, size_t const alignment, [[maybe_unused]] scope const allocation_scope ) noexcept
+{
+    auto const class_size = std::bit_ceil( std::max( { size, alignment, min_class_size } ) );
+    if( class_size > max_class_size )
+    {
+        aligned_release( memory );
+        return;
+    }
+
+    auto& target = classes_[ std::countr_zero( class_size ) - std::countr_zero( min_class_size ) ];
+    auto* const block = static_cast< free_block* >( memory );
+    std::lock_guard< std::mutex > lock( target.mutex );
+    block->next = target.free_list;
+    target.free_list = block;
+}
+
+bool arena_host_allocator::fits( size_t const size, size_t const alignment, scope const allocation_scope ) noexcept
+{
+    return scope::COMMAND == allocation_scope && size + alignment <= chunk_size - arena_chunk_header;
+}
+
+void* arena_host_allocator::acquire( size_t const size, size_t const alignment, scope const allocation_scope ) noexcept
+{
+    if( !fits( size, alignment, allocation_scope ) )
+    {
+        return fallback_.acquire( size, alignment, allocation_scope );
+    }
+
+    auto*& pcurrent = thread_arena.pcurrent;
+    if( nullptr != pcurrent && 1 == pcurrent->live.load( std::memory_order_acquire ) )
+    {
+        // nothing handed out of the chunk is alive anymore, start over from its beginning
+        pcurrent->offset = arena_chunk_header;
+    }
+    auto offset = nullptr != pcurrent ? align_up( pcurrent->offset, alignment ) : chunk_size;
+    if( offset + size > chunk_size )
+    {
+        auto* const memory = aligned_allocate( chunk_size, chunk_size );
+        if( nullptr == memory )
+        {
+            return nullptr;
+        }
+        if( nullptr != pcurrent )
+        {
+            drop_reference( pcurrent );
+        }
+        pcurrent = new( memory ) arena_chunk();
+        offset = align_up( arena_chunk_header, alignment );
+    }
+
+    pcurrent->live.fetch_add( 1, std::memory_order_relaxed );
+    pcurrent->offset = offset + size;
+    return reinterpret_cast< char* >( pcurrent ) + offset;
+}
+
+void arena_host_allocator::release( void* const memory, size_t const size, size_t const alignment, scope const allocation_scope ) noexcept
+{
+    if( !fits( size, alignment, allocation_scope ) )
+    {
+        fallback_.release( memory, size, alignment, allocation_scope );
+        return;
+    }
+    drop_reference( reinterpret_cast< arena_chunk* >( reinterpret_cast< uintptr_t >( memory ) & ~( uintptr_t( chunk_size ) - 1 ) ) );
+}
+
+} // namespace vkcpp
@@ -0,0 +1,235 @@
+#include <vkcpp/instrument.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <ostream>
+
+namespace
+{
+using vkcpp::instrument::histogram_size;
+
+constexpr size_t const call_count = static_cast< size_t >( vkcpp::api_call::MAX_CALL );
+
+constexpr std::array< std::string_view, call_count > const call_names{ "vkEnumerateInstanceLayerProperties",
+                                                                       "vkEnumerateInstanceExtensionProperties",
+                                                                       "vkCreateInstance",
+                                                                       "vkCreateDebugReportCallbackEXT",
+                                                                       "vkEnumeratePhysicalDevices",
+                                                                       "vkEnumerateDeviceExtensionProperties",
+                                                                       "vkGetPhysicalDeviceQueueFamilyProperties",
+                                                                       "vkCreateDevice",
+                                                                       "vkGetDeviceQueue",
+                                                                       "vkQueueSubmit",
+                                                                       "vkQueueWaitIdle",
+                                                                       "vkDeviceWaitIdle",
+                                                                       "vkAllocateMemory",
+                                                                       "vkMapMemory",
+                                                                       "vkUnmapMemory",
+                                                                       "vkBeginCommandBuffer",
+                                                                       "vkEndCommandBuffer",
+                                                                       "vkResetCommandBuffer",
+                                                                       "vkCreateCommandPool",
+                                                                       "vkAllocateCommandBuffers",
+                                                                       "vkFreeCommandBuffers",
+                                                                       "vkResetCommandPool",
+                                                                       "vkCreatePipelineCache",
+                                                                       "vkGetPipelineCacheData",
+                                                                       "vkMergePipelineCaches",
+                                                                       "vkCreateComputePipelines",
+                                                                       "vkCreateGraphicsPipelines",
+                                                                       "vkCreateShaderModule",
+                                                                       "vkCreateDescriptorSetLayout",
+                                                                       "vkCreatePipelineLayout",
+                                                                       "vkCreateSampler",
+                                                                       "vkCreateDescriptorPool",
+                                                                       "vkAllocateDescriptorSets",
+                                                                       "vkResetDescriptorPool",
+                                                                       "vkCreateQueryPool",
+                                                                       "vkGetQueryPoolResults",
+                                                                       "vkCreateDescriptorUpdateTemplate",
+                                                                       "vkCreateFence",
+                                                                       "vkWaitForFences",
+                                                                       "vkGetFenceStatus",
+                                                                       "vkResetFences",
+                                                                       "vkCreateSemaphore",
+                                                                       "vkGetSemaphoreCounterValue",
+                                                                       "vkSignalSemaphore",
+                                                                       "vkWaitSemaphores" };
+
+// written by the owning thread only, so increments are a plain load and store; snapshots read them from any thread
+struct thread_counters
+{
+    struct counter
+    {
+        std::atomic< uint64_t > count{ 0 };
+        std::atomic< uint64_t > total_nanoseconds{ 0 };
+        std::array< std::atomic< uint64_t >, histogram_size > histogram{};
+    };
+
+    std::array< counter, call_count > counters{};
+};
+
+void add( std::atomic< uint64_t >& value, uint64_t const amount ) noexcept
+{
+    value.store( value.load( std::memory_order_relaxed ) + amount, std::memory_order_relaxed );
+}
+
+using call_table = std::array< vkcpp::instrument::call_statistics, call_count >;
+
+void accumulate( call_table& target, thread_counters const& counters ) noexcept
+{
+    for( size_t ic = 0; ic < call_count; ++ic )
+    {
+        auto const& source = counters.counters[ ic ];
+        target[ ic ].count += source.count.load( std::memory_order_relaxed );
+        target[ ic ].total_nanoseconds += source.total_nanoseconds.load( std::memory_order_relaxed );
+        for( size_t ib = 0; ib < histogram_size; ++ib )
+        {
+            target[ ic ].histogram[ ib ] += source.histogram[ ib ].load( std::memory_order_relaxed );
+        }
+    }
+}
+
+// counters of the running threads, and the sums of the ones that ended
+struct counter_registry
+{
+    std::mutex mutex;
+    std::vector< thread_counters const* > live;
+    call_table ended{};
+};
+
+counter_registry& registry()
+{
+    static counter_registry instance;
+    return instance;
+}
+
+struct thread_registration
+{
+    thread_counters counters;
+
+    thread_registration()
+    {
+        auto& counters_of = registry();
+        std::lock_guard< std::mutex > lock( counters_of.mutex );
+        counters_of.live.push_back( &counters );
+    }
+
+    ~thread_registration()
+    {
+        auto& counters_of = registry();
+        std::lock_guard< std::mutex > lock( counters_of.mutex );
+        accumulate( counters_of.ended, counters );
+        std::erase( counters_of.live, &counters );
+    }
+};
+
+thread_counters& local_counters()
+{
+    thread_local thread_registration registration;
+    return registration.counters;
+}
+
+} // namespace
+
+namespace vkcpp
+{
+namespace private_
+{
+void record_call( api_call const call, int64_t const nanoseconds ) noexcept
+{
+    auto const elapsed = static_cast< uint64_t >( std::max( nanoseconds, int64_t( 0 ) ) );
+    auto& counter = local_counters().counters[ static_cast< size_t >( call ) ];
+    add( counter.count, 1 );
+    add( counter.total_nanoseconds, elapsed );
+    add( counter.histogram[ std::min( static_cast< size_t >( std::bit_width( elapsed ) ), histogram_size - 1 ) ], 1 );
+}
+
+} // namespace private_
+
+namespace instrument
+{
+std::string_view name( api_call const call ) noexcept
+{
+    auto const index = static_cast< size_t >( call );
+    return index < call_count ? call_names[ index ] : std::string_view();
+}
+
+uint64_t call_statistics::percentile( double const share ) const noexcept
+{
+    auto const wanted = static_cast< uint64_t >( std::clamp( share, 0.0, 1.0 ) * static_cast< double >( count ) );
+    uint64_t seen = 0;
+    for( size_t ib = 0; ib + 1 < histogram_size; ++ib )
+    {
+        seen += histogram[ ib ];
+        if( 0 < seen && wanted <= seen )
+        {
+            return uint64_t( 1 ) << ib;
+        }
+    }
+    return std::numeric_limits< uint64_t >::max();
+}
+
+snapshot::snapshot() noexcept
+{
+    for( size_t ic = 0; ic < call_count; ++ic )
+    {
+        calls_[ ic ].call = static_cast< api_call >( ic );
+    }
+}
+
+snapshot snapshot::take()
+{
+    snapshot result;
+    if constexpr( enabled )
+    {
+        auto& counters_of = registry();
+        std::lock_guard< std::mutex > lock( counters_of.mutex );
+        result.calls_ = counters_of.ended;
+        for( auto const* const pcounters: counters_of.live )
+        {
+            accumulate( result.calls_, *pcounters );
+        }
+        for( size_t ic = 0; ic < call_count; ++ic )
+        {
+            result.calls_[ ic ].call = static_cast< api_call >( ic );
+        }
+    }
+    return result;
+}
+
+snapshot snapshot::since( snapshot const& earlier ) const noexcept
+{
+    snapshot result;
+    for( size_t ic = 0; ic < call_count; ++ic )
+    {
+        auto const& later_call = calls_[ ic ];
+        auto const& earlier_call = earlier.calls_[ ic ];
+        auto& target = result.calls_[ ic ];
+        target.count = later_call.count - earlier_call.count;
+        target.total_nanoseconds = later_call.total_nanoseconds - earlier_call.total_nanoseconds;
+        for( size_t ib = 0; ib < histogram_size; ++ib )
+        {
+            target.histogram[ ib ] = later_call.histogram[ ib ] - earlier_call.histogram[ ib ];
+        }
+    }
+    return result;
+}
+
+void snapshot::dump( std::ostream& stream ) const
+{
+    for( auto const& ic: calls_ )
+    {
+        if( 0 == ic.count )
+        {
+            continue;
+        }
+        stream << name( ic.call ) << " count " << ic.count << " total " << ic.total_nanoseconds << "ns average " << static_cast< uint64_t >( ic.average() )
+               << "ns p50 <" << ic.percentile( 0.5 ) << "ns p99 <" << ic.percentile( 0.99 ) << "ns\n";
+    }
+}
+
+} // namespace instrument
+} // namespace vkcpp
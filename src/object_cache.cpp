@@ -0,0 +1,200 @@
+#include <vkcpp/object_cache.hpp>
+
+#include <cassert>
+
+namespace vkcpp
+{
+object_cache::object_cache( device const& device )
+    : device_( device )
+{
+    assert( device );
+}
+
+template< typename handle_type, typename create_type >
+std::shared_ptr< handle_type const > object_cache::intern( table< handle_type >& objects, private_::content_key&& key, sources_type&& sources,
+                                                          create_type const& create )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        auto const io = objects.objects.find( key.bytes() );
+        if( io != objects.objects.end() )
+        {
+            ++objects.hits;
+            return io->second;
+        }
+        ++objects.misses;
+    }
+
+    // created outside the lock so one slow driver call does not hold up lookups of everything else; when two threads
+    // race for the same content the first one in wins and the other object is dropped
+    auto created = std::make_shared< with_sources< handle_type > >( with_sources< handle_type >{ std::move( sources ), create() } );
+    std::shared_ptr< handle_type const > object( created, &created->object );
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto const [ io, inserted ] = objects.objects.try_emplace( key.bytes(), std::move( object ) );
+    if( inserted )
+    {
+        objects.keys.emplace( io->second->native(), std::move( key ).bytes() );
+    }
+    return io->second;
+}
+
+template< typename handle_type >
+bool object_cache::add_source( private_::content_key& key, sources_type& sources, table< handle_type > const& objects,
+                               typename handle_type::native_type const native )
+{
+    auto const ik = objects.keys.find( native );
+    if( ik == objects.keys.end() )
+    {
+        return false;
+    }
+    key.add( std::string_view( ik->second ) );
+    sources.push_back( objects.objects.at( ik->second ) );
+    return true;
+}
+
+template< typename handle_type >
+size_t object_cache::trim( table< handle_type >& objects )
+{
+    return std::erase_if( objects.objects,
+                          [ & ]( auto const& io )
+                          {
+                              if( 1 < io.second.use_count() )
+                              {
+                                  return false;
+                              }
+                              objects.keys.erase( io.second->native() );
+                              return true;
+                          } );
+}
+
+std::shared_ptr< shader_module const > object_cache::shader_module( std::span< uint32_t const > const code )
+{
+    private_::content_key key;
+    key.add( code );
+    return intern( shader_modules_, std::move( key ), sources_type(), [ & ]() { return vkcpp::shader_module( device_, code ); } );
+}
+
+std::shared_ptr< descriptor_set_layout const > object_cache::descriptor_set_layout( VkDescriptorSetLayoutCreateInfo const& info )
+{
+    assert( nullptr == info.pNext );
+    private_::content_key key;
+    sources_type sources;
+    key.add( info.flags ).add( info.bindingCount );
+    bool known = true;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        for( uint32_t ib = 0; ib < info.bindingCount && known; ++ib )
+        {
+            auto const& binding = info.pBindings[ ib ];
+            key.add( binding.binding ).add( binding.descriptorType ).add( binding.descriptorCount ).add( binding.stageFlags );
+            // immutable samplers, when given, come one for each descriptor
+            auto const sampler_count = nullptr == binding.pImmutableSamplers ? 0 : binding.descriptorCount;
+            key.add( sampler_count );
+            for( uint32_t is = 0; is < sampler_count && known; ++is )
+            {
+                known = add_source( key, sources, samplers_, binding.pImmutableSamplers[ is ] );
+            }
+        }
+        if( !known )
+        {
+            ++descriptor_set_layouts_.misses;
+        }
+    }
+    if( !known )
+    {
+        return std::make_shared< vkcpp::descriptor_set_layout const >( device_, info );
+    }
+    return intern( descriptor_set_layouts_, std::move( key ), std::move( sources ),
+                   [ & ]() { return vkcpp::descriptor_set_layout( device_, info ); } );
+}
+
+std::shared_ptr< pipeline_layout const > object_cache::pipeline_layout( VkPipelineLayoutCreateInfo const& info )
+{
+    assert( nullptr == info.pNext );
+    private_::content_key key;
+    sources_type sources;
+    key.add( info.flags ).add( info.setLayoutCount );
+    bool known = true;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        for( uint32_t is = 0; is < info.setLayoutCount && known; ++is )
+        {
+            known = add_source( key, sources, descriptor_set_layouts_, info.pSetLayouts[ is ] );
+        }
+        if( !known )
+        {
+            ++pipeline_layouts_.misses;
+        }
+    }
+    if( !known )
+    {
+        return std::make_shared< vkcpp::pipeline_layout const >( device_, info );
+    }
+    key.add( std::span< VkPushConstantRange const >( info.pPushConstantRanges, info.pushConstantRangeCount ) );
+    return intern( pipeline_layouts_, std::move( key ), std::move( sources ), [ & ]() { return vkcpp::pipeline_layout( device_, info ); } );
+}
+
+std::shared_ptr< sampler const > object_cache::sampler( VkSamplerCreateInfo const& info )
+{
+    assert( nullptr == info.pNext );
+    private_::content_key key;
+    key.add( info.flags )
+        .add( info.magFilter )
+        .add( info.minFilter )
+        .add( info.mipmapMode )
+        .add( info.addressModeU )
+        .add( info.addressModeV )
+        .add( info.addressModeW )
+        .add( info.mipLodBias )
+        .add( info.anisotropyEnable )
+        .add( info.maxAnisotropy )
+        .add( info.compareEnable )
+        .add( info.compareOp )
+        .add( info.minLod )
+        .add( info.maxLod )
+        .add( info.borderColor )
+        .add( info.unnormalizedCoordinates );
+    return intern( samplers_, std::move( key ), sources_type(), [ & ]() { return vkcpp::sampler( device_, info ); } );
+}
+
+size_t object_cache::trim()
+{
+    // dependents first: a pipeline layout going drops its hold on its set layouts, which may then go in the same pass
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return trim( pipeline_layouts_ ) + trim( descriptor_set_layouts_ ) + trim( samplers_ ) + trim( shader_modules_ );
+}
+
+std::string object_cache::shader_module_key( VkShaderModule const module ) const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto const ik = shader_modules_.keys.find( module );
+    return ik != shader_modules_.keys.end() ? ik->second : std::string();
+}
+
+std::string object_cache::pipeline_layout_key( VkPipelineLayout const layout ) const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto const ik = pipeline_layouts_.keys.find( layout );
+    return ik != pipeline_layouts_.keys.end() ? ik->second : std::string();
+}
+
+object_cache::statistics object_cache::stats( kind const object_kind ) const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto const of = []( auto const& objects ) { return statistics{ objects.hits, objects.misses, objects.objects.size() }; };
+    switch( object_kind )
+    {
+    case kind::SHADER_MODULE:
+        return of( shader_modules_ );
+    case kind::DESCRIPTOR_SET_LAYOUT:
+        return of( descriptor_set_layouts_ );
+    case kind::PIPELINE_LAYOUT:
+        return of( pipeline_layouts_ );
+    case kind::SAMPLER:
+        return of( samplers_ );
+    default:
+        return statistics();
+    }
+}
+
+} // namespace vkcpp
@@ -0,0 +1,284 @@
+#include <vkcpp/pipeline.hpp>
+
+#include <cassert>
+
+namespace
+{
+// create info of a shader stage, pointing into the stage and into the specialization info kept alongside
+VkPipelineShaderStageCreateInfo stage_info( vkcpp::shader_stage const& stage, VkSpecializationInfo& specialization )
+{
+    specialization = VkSpecializationInfo{ .mapEntryCount = static_cast< uint32_t >( stage.specialization_entries.size() ),
+                                           .pMapEntries = stage.specialization_entries.data(),
+                                           .dataSize = stage.specialization_data.size(),
+                                           .pData = stage.specialization_data.data() };
+    return VkPipelineShaderStageCreateInfo{ .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                                            .pNext = nullptr,
+                                            .flags = 0,
+                                            .stage = stage.stage,
+                                            .module = stage.module,
+                                            .pName = stage.entry_point.c_str(),
+                                            .pSpecializationInfo = stage.specialization_entries.empty() ? nullptr : &specialization };
+}
+
+} // namespace
+
+namespace vkcpp
+{
+void shader_stage::add_to( private_::content_key& key ) const
+{
+    assert( VK_NULL_HANDLE == module || !module_key.empty() );
+    key.add( stage ).add( std::string_view( module_key ) ).add( std::string_view( entry_point ) );
+    key.add( std::span< VkSpecializationMapEntry const >( specialization_entries ) ).add( std::span< std::byte const >( specialization_data ) );
+}
+
+private_::content_key compute_pipeline_description::key() const
+{
+    assert( VK_NULL_HANDLE == layout || !layout_key.empty() );
+    private_::content_key result;
+    stage.add_to( result );
+    result.add( std::string_view( layout_key ) ).add( flags );
+    return result;
+}
+
+pipeline compute_pipeline_description::create( device_reference const device, VkPipelineCache const cache ) const
+{
+    VkSpecializationInfo specialization{};
+    VkComputePipelineCreateInfo const info{ .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                                            .pNext = nullptr,
+                                            .flags = flags,
+                                            .stage = stage_info( stage, specialization ),
+                                            .layout = layout,
+                                            .basePipelineHandle = VK_NULL_HANDLE,
+                                            .basePipelineIndex = -1 };
+    return pipeline( device, info, cache );
+}
+
+private_::content_key graphics_pipeline_description::key() const
+{
+    assert( nullptr == rasterization.pNext && nullptr == multisample.pNext && nullptr == depth_stencil.pNext );
+    assert( VK_NULL_HANDLE == layout || !layout_key.empty() );
+    assert( VK_NULL_HANDLE == render_pass || !render_pass_key.empty() );
+    private_::content_key result;
+    result.add( stages.size() );
+    for( auto const& is: stages )
+    {
+        is.add_to( result );
+    }
+    result.add( std::span< VkVertexInputBindingDescription const >( vertex_bindings ) )
+        .add( std::span< VkVertexInputAttributeDescription const >( vertex_attributes ) );
+    result.add( topology ).add( primitive_restart ).add( patch_control_points );
+    result.add( viewport_count ).add( scissor_count ).add( viewports.size() );
+    for( auto const& iv: viewports )
+    {
+        result.add( iv.x ).add( iv.y ).add( iv.width ).add( iv.height ).add( iv.minDepth ).add( iv.maxDepth );
+    }
+    result.add( std::span< VkRect2D const >( scissors ) );
+    result.add( rasterization.flags )
+        .add( rasterization.depthClampEnable )
+        .add( rasterization.rasterizerDiscardEnable )
+        .add( rasterization.polygonMode )
+        .add( rasterization.cullMode )
+        .add( rasterization.frontFace )
+        .add( rasterization.depthBiasEnable )
+        .add( rasterization.depthBiasConstantFactor )
+        .add( rasterization.depthBiasClamp )
+        .add( rasterization.depthBiasSlopeFactor )
+        .add( rasterization.lineWidth );
+    result.add( multisample.flags )
+        .add( multisample.rasterizationSamples )
+        .add( multisample.sampleShadingEnable )
+        .add( multisample.minSampleShading )
+        .add( multisample.alphaToCoverageEnable )
+        .add( multisample.alphaToOneEnable );
+    // one mask word for every 32 samples
+    auto const mask_words = nullptr == multisample.pSampleMask ? 0 : ( static_cast< size_t >( multisample.rasterizationSamples ) + 31 ) / 32;
+    result.add( std::span< VkSampleMask const >( multisample.pSampleMask, mask_words ) );
+    result.add( depth_stencil.flags )
+        .add( depth_stencil.depthTestEnable )
+        .add( depth_stencil.depthWriteEnable )
+        .add( depth_stencil.depthCompareOp )
+        .add( depth_stencil.depthBoundsTestEnable )
+        .add( depth_stencil.stencilTestEnable )
+        .add( depth_stencil.front )
+        .add( depth_stencil.back )
+        .add( depth_stencil.minDepthBounds )
+        .add( depth_stencil.maxDepthBounds );
+    result.add( logic_op_enable ).add( logic_op ).add( std::span< VkPipelineColorBlendAttachmentState const >( blend_attachments ) );
+    result.add( blend_constants[ 0 ] ).add( blend_constants[ 1 ] ).add( blend_constants[ 2 ] ).add( blend_constants[ 3 ] );
+    result.add( std::span< VkDynamicState const >( dynamic_states ) );
+    result.add( std::string_view( layout_key ) ).add( std::string_view( render_pass_key ) ).add( subpass ).add( flags );
+    return result;
+}
+
+pipeline graphics_pipeline_description::create( device_reference const device, VkPipelineCache const cache ) const
+{
+    std::vector< VkSpecializationInfo > specializations( stages.size() );
+    std::vector< VkPipelineShaderStageCreateInfo > stage_infos;
+    stage_infos.reserve( stages.size() );
+    for( size_t is = 0; is < stages.size(); ++is )
+    {
+        stage_infos.push_back( stage_info( stages[ is ], specializations[ is ] ) );
+    }
+
+    VkPipelineVertexInputStateCreateInfo const vertex_input{ .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                                                             .pNext = nullptr,
+                                                             .flags = 0,
+                                                             .vertexBindingDescriptionCount = static_cast< uint32_t >( vertex_bindings.size() ),
+                                                             .pVertexBindingDescriptions = vertex_bindings.data(),
+                                                             .vertexAttributeDescriptionCount = static_cast< uint32_t >( vertex_attributes.size() ),
+                                                             .pVertexAttributeDescriptions = vertex_attributes.data() };
+    VkPipelineInputAssemblyStateCreateInfo const input_assembly{ .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+                                                                 .pNext = nullptr,
+                                                                 .flags = 0,
+                                                                 .topology = topology,
+                                                                 .primitiveRestartEnable = primitive_restart ? VK_TRUE : VK_FALSE };
+    VkPipelineTessellationStateCreateInfo const tessellation{ .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
+                                                              .pNext = nullptr,
+                                                              .flags = 0,
+                                                              .patchControlPoints = patch_control_points };
+    VkPipelineViewportStateCreateInfo const viewport{ .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                                                      .pNext = nullptr,
+                                                      .flags = 0,
+                                                      .viewportCount = viewport_count,
+                                                      .pViewports = viewports.empty() ? nullptr : viewports.data(),
+                                                      .scissorCount = scissor_count,
+                                                      .pScissors = scissors.empty() ? nullptr : scissors.data() };
+    VkPipelineColorBlendStateCreateInfo color_blend{ .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                                                     .pNext = nullptr,
+                                                     .flags = 0,
+                                                     .logicOpEnable = logic_op_enable ? VK_TRUE : VK_FALSE,
+                                                     .logicOp = logic_op,
+                                                     .attachmentCount = static_cast< uint32_t >( blend_attachments.size() ),
+                                                     .pAttachments = blend_attachments.data() };
+    std::copy( blend_constants.begin(), blend_constants.end(), color_blend.blendConstants );
+    VkPipelineDynamicStateCreateInfo const dynamic{ .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                                                    .pNext = nullptr,
+                                                    .flags = 0,
+                                                    .dynamicStateCount = static_cast< uint32_t >( dynamic_states.size() ),
+                                                    .pDynamicStates = dynamic_states.data() };
+
+    VkGraphicsPipelineCreateInfo const info{ .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                                             .pNext = nullptr,
+                                             .flags = flags,
+                                             .stageCount = static_cast< uint32_t >( stage_infos.size() ),
+                                             .pStages = stage_infos.data(),
+                                             .pVertexInputState = &vertex_input,
+                                             .pInputAssemblyState = &input_assembly,
+                                             .pTessellationState = 0 < patch_control_points ? &tessellation : nullptr,
+                                             .pViewportState = &viewport,
+                                             .pRasterizationState = &rasterization,
+                                             .pMultisampleState = &multisample,
+                                             .pDepthStencilState = &depth_stencil,
+                                             .pColorBlendState = &color_blend,
+                                             .pDynamicState = dynamic_states.empty() ? nullptr : &dynamic,
+                                             .layout = layout,
+                                             .renderPass = render_pass,
+                                             .subpass = subpass,
+                                             .basePipelineHandle = VK_NULL_HANDLE,
+                                             .basePipelineIndex = -1 };
+    return pipeline( device, info, cache );
+}
+
+pipeline_compiler::pipeline_compiler( device const& device, VkPipelineCache const cache, size_t const thread_count )
+    : device_( device )
+    , cache_( cache )
+{
+    start( thread_count );
+}
+
+pipeline_compiler::pipeline_compiler( device const& device, persistent_pipeline_cache const& cache, size_t const thread_count )
+    : device_( device )
+    , cache_( cache.native() )
+    , ppersistent_cache_( &cache )
+{
+    start( thread_count );
+}
+
+void pipeline_compiler::start( size_t const thread_count )
+{
+    assert( device_ );
+    workers_.reserve( std::max( thread_count, size_t( 1 ) ) );
+    for( size_t it = 0; it < workers_.capacity(); ++it )
+    {
+        workers_.emplace_back( [ this ]( std::stop_token const& stop ) { run( stop ); } );
+    }
+}
+
+pipeline_compiler::~pipeline_compiler()
+{
+    for( auto& iw: workers_ )
+    {
+        iw.request_stop();
+    }
+    condition_.notify_all();
+    workers_.clear();
+}
+
+size_t pipeline_compiler::pending() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return requests_.size();
+}
+
+pipeline_compiler::statistics pipeline_compiler::stats() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return stats_;
+}
+
+void pipeline_compiler::run( std::stop_token const& stop )
+{
+    while( true )
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        if( !condition_.wait( lock, stop, [ this ]() { return !requests_.empty(); } ) )
+        {
+            return;
+        }
+        auto work = std::move( requests_.front() );
+        requests_.pop_front();
+        lock.unlock();
+
+        shared_pipeline compiled;
+        std::exception_ptr error;
+        try
+        {
+            std::shared_lock< std::shared_mutex > creation;
+            if( nullptr != ppersistent_cache_ )
+            {
+                creation = ppersistent_cache_->creation_lock();
+            }
+            compiled = std::make_shared< pipeline const >(
+                std::visit( [ this ]( auto const& description ) { return description.create( device_, cache_ ); }, work.description ) );
+        }
+        catch( ... )
+        {
+            error = std::current_exception();
+        }
+
+        // counted before the future is fulfilled, so stats already include a pipeline its waiter just received
+        lock.lock();
+        if( error )
+        {
+            ++stats_.failed;
+            // a failed variant is not remembered, so asking again compiles it again
+            pipelines_.erase( work.key );
+        }
+        else
+        {
+            ++stats_.compiled;
+        }
+        lock.unlock();
+
+        if( error )
+        {
+            work.promise.set_exception( error );
+        }
+        else
+        {
+            work.promise.set_value( std::move( compiled ) );
+        }
+    }
+}
+
+} // namespace vkcpp
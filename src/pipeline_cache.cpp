@@ -0,0 +1,243 @@
+#include <vkcpp/pipeline_cache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// read only view of a whole file, empty when the file is missing or unreadable
+class mapped_file
+{
+public:
+    explicit mapped_file( std::filesystem::path const& path )
+    {
+#ifdef _WIN32
+        std::ifstream stream( path, std::ios::binary | std::ios::ate );
+        if( stream )
+        {
+            copy_.resize( static_cast< size_t >( stream.tellg() ) );
+            stream.seekg( 0 );
+            if( stream.read( reinterpret_cast< char* >( copy_.data() ), static_cast< std::streamsize >( copy_.size() ) ) )
+            {
+                data_ = copy_;
+            }
+        }
+#else
+        auto const fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( 0 > fd )
+        {
+            return;
+        }
+        struct stat status
+        {
+        };
+        if( 0 == ::fstat( fd, &status ) && 0 < status.st_size )
+        {
+            auto* const address = ::mmap( nullptr, static_cast< size_t >( status.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( MAP_FAILED != address )
+            {
+                data_ = std::span< std::byte const >( static_cast< std::byte const* >( address ), static_cast< size_t >( status.st_size ) );
+            }
+        }
+        // the mapping stays valid without the descriptor
+        ::close( fd );
+#endif
+    }
+
+    mapped_file( mapped_file& ) = delete;
+    mapped_file& operator=( mapped_file& ) = delete;
+
+    ~mapped_file()
+    {
+#ifndef _WIN32
+        if( !data_.empty() )
+        {
+            ::munmap( const_cast< std::byte* >( data_.data() ), data_.size() );
+        }
+#endif
+    }
+
+    [[nodiscard]] std::span< std::byte const > data() const noexcept { return data_; }
+
+private:
+    std::span< std::byte const > data_;
+#ifdef _WIN32
+    std::vector< std::byte > copy_;
+#endif
+};
+
+// tells apart the temporary files of saves running at the same time, in this process and in others
+std::atomic< unsigned > save_count{ 0 };
+
+std::filesystem::path temporary_path( std::filesystem::path const& path )
+{
+#ifdef _WIN32
+    auto const process = ::_getpid();
+#else
+    auto const process = ::getpid();
+#endif
+    auto result = path;
+    result += "." + std::to_string( process ) + "." + std::to_string( save_count.fetch_add( 1, std::memory_order_relaxed ) ) + ".tmp";
+    return result;
+}
+
+// writes a new file and has it on disk before returning, so a rename over the old one never exposes a torn file
+void write_through( std::filesystem::path const& path, std::span< std::byte const > data )
+{
+    auto const fail = [ & ]() { throw std::filesystem::filesystem_error( "pipeline cache write", path, std::error_code( errno, std::generic_category() ) ); };
+#ifdef _WIN32
+    auto const fd = ::_wopen( path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE );
+#else
+    auto const fd = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+#endif
+    if( 0 > fd )
+    {
+        fail();
+    }
+    try
+    {
+        while( !data.empty() )
+        {
+#ifdef _WIN32
+            auto const written = ::_write( fd, data.data(), static_cast< unsigned >( std::min( data.size(), size_t( 1 ) << 30U ) ) );
+#else
+            auto const written = ::write( fd, data.data(), data.size() );
+            if( 0 > written && EINTR == errno )
+            {
+                continue;
+            }
+#endif
+            if( 0 > written )
+            {
+                fail();
+            }
+            data = data.subspan( static_cast< size_t >( written ) );
+        }
+#ifdef _WIN32
+        if( 0 != ::_commit( fd ) )
+#else
+        if( 0 != ::fsync( fd ) )
+#endif
+        {
+            fail();
+        }
+    }
+    catch( ... )
+    {
+#ifdef _WIN32
+        ::_close( fd );
+#else
+        ::close( fd );
+#endif
+        throw;
+    }
+#ifdef _WIN32
+    if( 0 != ::_close( fd ) )
+#else
+    if( 0 != ::close( fd ) )
+#endif
+    {
+        fail();
+    }
+}
+
+template< typename value_type >
+value_type read_at( std::span< std::byte const > const data, size_t const offset ) noexcept
+{
+    value_type result;
+    std::memcpy( &result, data.data() + offset, sizeof( result ) );
+    return result;
+}
+
+} // namespace
+
+namespace vkcpp
+{
+persistent_pipeline_cache::persistent_pipeline_cache( device const& device, physical_device const physical_device, std::filesystem::path path )
+    : device_( device )
+    , property_( physical_device )
+    , path_( std::move( path ) )
+{
+    mapped_file const file( path_ );
+    warm_ = compatible( file.data(), property_ );
+    // the driver copies the initial data, so the mapping can go right after
+    cache_ = pipeline_cache( device, warm_ ? file.data() : std::span< std::byte const >() );
+}
+
+persistent_pipeline_cache::~persistent_pipeline_cache()
+{
+    try
+    {
+        save();
+    }
+    catch( std::exception const& )
+    {
+        // the next run starts cold, nothing else is lost
+    }
+}
+
+bool persistent_pipeline_cache::compatible( std::span< std::byte const > const data, physical_device::property const& property ) noexcept
+{
+    // headerSize, headerVersion, vendorID, deviceID and pipelineCacheUUID, as laid out by VkPipelineCacheHeaderVersionOne
+    constexpr size_t const header_size = 4 * sizeof( uint32_t ) + VK_UUID_SIZE;
+    if( data.size() < header_size )
+    {
+        return false;
+    }
+    auto const stored_header_size = read_at< uint32_t >( data, 0 );
+    return header_size <= stored_header_size && stored_header_size <= data.size() &&
+           VK_PIPELINE_CACHE_HEADER_VERSION_ONE == read_at< uint32_t >( data, 4 ) && property.vendorID == read_at< uint32_t >( data, 8 ) &&
+           property.deviceID == read_at< uint32_t >( data, 12 ) && 0 == std::memcmp( data.data() + 16, property.pipelineCacheUUID, VK_UUID_SIZE );
+}
+
+void persistent_pipeline_cache::merge( std::span< VkPipelineCache const > const worker_caches )
+{
+    // the destination of a merge is externally synchronised, against other merges and against pipeline creation
+    std::lock_guard< std::shared_mutex > lock( mutex_ );
+    cache_.merge( worker_caches );
+}
+
+void persistent_pipeline_cache::save() const
+{
+    std::vector< std::byte > data;
+    {
+        std::shared_lock< std::shared_mutex > lock( mutex_ );
+        data = cache_.data();
+    }
+
+    if( path_.has_parent_path() )
+    {
+        std::filesystem::create_directories( path_.parent_path() );
+    }
+    auto const temporary = temporary_path( path_ );
+    try
+    {
+        write_through( temporary, data );
+        std::filesystem::rename( temporary, path_ );
+    }
+    catch( std::exception const& )
+    {
+        std::error_code ignored;
+        std::filesystem::remove( temporary, ignored );
+        throw;
+    }
+}
+
+} // namespace vkcpp
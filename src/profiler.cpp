@@ -0,0 +1,406 @@
+#include <vkcpp/profiler.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <numeric>
+
+namespace vkcpp
+{
+struct profiler::node
+{
+    std::string name;
+    size_t parent;
+    uint32_t depth;
+    std::vector< size_t > children;
+    uint64_t sample_count{ 0 };
+    double last{ 0.0 };
+    // ring of the last window samples
+    std::vector< double > samples;
+    std::vector< uint64_t > statistics;
+};
+
+struct profiler::frame_slot
+{
+    query_pool pool;
+    // zone of each begin and end query pair, in query order
+    std::vector< size_t > zones;
+    query_pool statistics_pool;
+    // statistics queries can not nest, so a zone's count is split into segments that pause while a child runs;
+    // this is the zone of each segment, in query order
+    std::vector< size_t > segments;
+};
+
+profiler::scoped_zone::scoped_zone( profiler& profiler, command_buffer const& buffer, std::string_view const name )
+{
+    if( profiler.enabled() && profiler.begin_zone( buffer, name, query_ ) )
+    {
+        pprofiler_ = &profiler;
+        buffer_ = buffer;
+    }
+}
+
+profiler::scoped_zone::~scoped_zone()
+{
+    if( nullptr != pprofiler_ )
+    {
+        pprofiler_->end_zone( buffer_, query_ );
+    }
+}
+
+profiler::profiler( device const& device, physical_device const physical_device, device::queue::family::id_type const family_index,
+                    uint32_t const frame_count, uint32_t const max_zones, size_t const window, VkQueryPipelineStatisticFlags const statistics )
+    : enabled_( false )
+    , period_( physical_device::property( physical_device ).limits.timestampPeriod )
+    , tick_mask_( 0 )
+    , statistics_( physical_device::feature( physical_device ).pipelineStatisticsQuery ? statistics : 0 )
+    , statistic_count_( static_cast< uint32_t >( std::popcount( statistics_ ) ) )
+    , max_zones_( max_zones )
+    , window_( std::max( window, size_t( 1 ) ) )
+{
+    assert( 0 < frame_count && 0 < max_zones );
+    auto const families = device::queue::family::enumerate( physical_device );
+    auto const valid_bits = family_index < families.size() ? families[ family_index ].timestampValidBits : 0;
+    tick_mask_ = 64 <= valid_bits ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << valid_bits ) - 1;
+    if( !supported() )
+    {
+        return;
+    }
+
+    slots_.reserve( frame_count );
+    for( uint32_t is = 0; is < frame_count; ++is )
+    {
+        slots_.push_back( frame_slot{ query_pool( device, VK_QUERY_TYPE_TIMESTAMP, 2 * max_zones ), {}, {}, {} } );
+        if( 0 != statistics_ )
+        {
+            // every zone starts one segment and resumes its parent's when it ends
+            slots_.back().statistics_pool = query_pool( device, VK_QUERY_TYPE_PIPELINE_STATISTICS, 2 * max_zones, statistics_ );
+        }
+    }
+    // the first begin_frame moves on to slot 0
+    current_ = frame_count - 1;
+    enabled_.store( true, std::memory_order_relaxed );
+}
+
+profiler::~profiler() = default;
+
+void profiler::begin_frame( command_buffer const& buffer )
+{
+    if( !supported() )
+    {
+        return;
+    }
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    assert( open_.empty() );
+    current_ = ( current_ + 1 ) % slots_.size();
+    auto& slot = slots_[ current_ ];
+    collect( slot );
+    collect_statistics( slot );
+    slot.zones.clear();
+    slot.segments.clear();
+    buffer.reset_queries( slot.pool.native(), 0, slot.pool.count() );
+    if( slot.statistics_pool )
+    {
+        buffer.reset_queries( slot.statistics_pool.native(), 0, slot.statistics_pool.count() );
+    }
+}
+
+void profiler::collect( frame_slot& slot )
+{
+    if( slot.zones.empty() )
+    {
+        return;
+    }
+
+    // value and availability of each query, so whatever finished is used even when the rest has not
+    auto const query_count = static_cast< uint32_t >( 2 * slot.zones.size() );
+    std::vector< uint64_t > results( 2 * query_count );
+    auto const status = slot.pool.try_results( 0, query_count, std::as_writable_bytes( std::span( results ) ), 2 * sizeof( uint64_t ),
+                                               VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT );
+    if( !status && result::NOT_READY != status.status() )
+    {
+        status.value();
+    }
+
+    bool complete = true;
+    for( size_t iz = 0; iz < slot.zones.size(); ++iz )
+    {
+        auto const* const begin = &results[ 4 * iz ];
+        auto const* const end = begin + 2;
+        if( 0 == begin[ 1 ] || 0 == end[ 1 ] )
+        {
+            complete = false;
+            continue;
+        }
+
+        auto& zone = nodes_[ slot.zones[ iz ] ];
+        zone.last = static_cast< double >( ( end[ 0 ] - begin[ 0 ] ) & tick_mask_ ) * period_;
+        if( zone.samples.size() < window_ )
+        {
+            zone.samples.push_back( zone.last );
+        }
+        else
+        {
+            zone.samples[ zone.sample_count % window_ ] = zone.last;
+        }
+        ++zone.sample_count;
+        if( listener_ )
+        {
+            auto const begin_time = static_cast< double >( begin[ 0 ] & tick_mask_ ) * period_;
+            listener_( zone.name, zone.depth, begin_time, begin_time + zone.last );
+        }
+    }
+    dropped_ += complete ? 0 : 1;
+}
+
+void profiler::collect_statistics( frame_slot& slot )
+{
+    if( slot.segments.empty() )
+    {
+        return;
+    }
+
+    auto const stride = statistic_count_ + 1;
+    auto const query_count = static_cast< uint32_t >( slot.segments.size() );
+    std::vector< uint64_t > results( stride * query_count );
+    auto const status = slot.statistics_pool.try_results( 0, query_count, std::as_writable_bytes( std::span( results ) ), stride * sizeof( uint64_t ),
+                                                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT );
+    if( !status && result::NOT_READY != status.status() )
+    {
+        status.value();
+    }
+
+    // counts of a partly finished frame would be too low for some zones, so only complete frames are used
+    std::vector< std::vector< uint64_t > > counts( nodes_.size() );
+    for( size_t is = 0; is < slot.segments.size(); ++is )
+    {
+        auto const* const values = &results[ stride * is ];
+        if( 0 == values[ statistic_count_ ] )
+        {
+            return;
+        }
+        auto& zone_counts = counts[ slot.segments[ is ] ];
+        zone_counts.resize( statistic_count_ );
+        std::transform( zone_counts.begin(), zone_counts.end(), values, zone_counts.begin(), std::plus<>() );
+    }
+
+    // children always come after their parent, so walking backwards adds every zone's total before its parent's
+    for( auto in = nodes_.size(); 0 < in--; )
+    {
+        if( counts[ in ].empty() )
+        {
+            continue;
+        }
+        auto const parent = nodes_[ in ].parent;
+        if( no_parent != parent )
+        {
+            counts[ parent ].resize( statistic_count_ );
+            std::transform( counts[ parent ].begin(), counts[ parent ].end(), counts[ in ].begin(), counts[ parent ].begin(), std::plus<>() );
+        }
+        nodes_[ in ].statistics = std::move( counts[ in ] );
+    }
+}
+
+size_t profiler::child_of( size_t const parent, std::string_view const name )
+{
+    auto const& siblings = no_parent == parent ? roots_ : nodes_[ parent ].children;
+    for( auto const ic: siblings )
+    {
+        if( nodes_[ ic ].name == name )
+        {
+            return ic;
+        }
+    }
+
+    // a zone seen for the first time
+    auto const depth = no_parent == parent ? 0 : nodes_[ parent ].depth + 1;
+    nodes_.push_back( node{ std::string( name ), parent, depth, {} } );
+    ( no_parent == parent ? roots_ : nodes_[ parent ].children ).push_back( nodes_.size() - 1 );
+    return nodes_.size() - 1;
+}
+
+bool profiler::begin_zone( command_buffer const& buffer, std::string_view const name, uint32_t& query )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto& slot = slots_[ current_ ];
+    if( slot.zones.size() == max_zones_ )
+    {
+        return false;
+    }
+
+    auto& open = open_[ buffer.native() ];
+    auto const zone = child_of( open.zones.empty() ? no_parent : open.zones.back(), name );
+    query = static_cast< uint32_t >( 2 * slot.zones.size() );
+    slot.zones.push_back( zone );
+    buffer.write_timestamp( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, slot.pool.native(), query );
+    if( slot.statistics_pool )
+    {
+        if( !open.zones.empty() )
+        {
+            buffer.end_query( slot.statistics_pool.native(), open.segment );
+        }
+        open.segment = static_cast< uint32_t >( slot.segments.size() );
+        buffer.begin_query( slot.statistics_pool.native(), open.segment );
+        slot.segments.push_back( zone );
+    }
+    open.zones.push_back( zone );
+    return true;
+}
+
+void profiler::end_zone( command_buffer const& buffer, uint32_t const query )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto const iopen = open_.find( buffer.native() );
+    assert( open_.end() != iopen && !iopen->second.zones.empty() );
+    auto& open = iopen->second;
+    open.zones.pop_back();
+    auto& slot = slots_[ current_ ];
+    if( slot.statistics_pool )
+    {
+        buffer.end_query( slot.statistics_pool.native(), open.segment );
+        if( !open.zones.empty() )
+        {
+            open.segment = static_cast< uint32_t >( slot.segments.size() );
+            buffer.begin_query( slot.statistics_pool.native(), open.segment );
+            slot.segments.push_back( open.zones.back() );
+        }
+    }
+    buffer.write_timestamp( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, slot.pool.native(), query + 1 );
+    if( open.zones.empty() )
+    {
+        open_.erase( iopen );
+    }
+}
+
+void profiler::set_zone_listener( zone_listener listener )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    listener_ = std::move( listener );
+}
+
+std::vector< profiler::zone > profiler::zones() const
+{
+    std::vector< zone > result;
+    std::lock_guard< std::mutex > lock( mutex_ );
+    result.reserve( nodes_.size() );
+
+    // depth first, a zone's parent index refers to its position in the result
+    std::vector< std::pair< size_t, size_t > > pending;
+    for( auto ir = roots_.rbegin(); ir != roots_.rend(); ++ir )
+    {
+        pending.emplace_back( *ir, no_parent );
+    }
+    while( !pending.empty() )
+    {
+        auto const [ in, parent ] = pending.back();
+        pending.pop_back();
+
+        auto const& source = nodes_[ in ];
+        zone entry{ source.name, parent, source.depth, source.sample_count, source.last };
+        entry.statistics = source.statistics;
+        if( !source.samples.empty() )
+        {
+            auto const [ min, max ] = std::minmax_element( source.samples.begin(), source.samples.end() );
+            entry.average = std::accumulate( source.samples.begin(), source.samples.end(), 0.0 ) / static_cast< double >( source.samples.size() );
+            entry.min = *min;
+            entry.max = *max;
+        }
+        result.push_back( std::move( entry ) );
+
+        for( auto ic = source.children.rbegin(); ic != source.children.rend(); ++ic )
+        {
+            pending.emplace_back( *ic, result.size() - 1 );
+        }
+    }
+    return result;
+}
+
+uint64_t profiler::dropped_frames() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return dropped_;
+}
+
+performance_query::profiling_lock::profiling_lock( device const& device, uint64_t const timeout )
+    : device_( device )
+{
+    assert( nullptr != device.dispatch().acquire_profiling_lock );
+    VkAcquireProfilingLockInfoKHR info{ .sType = VK_STRUCTURE_TYPE_ACQUIRE_PROFILING_LOCK_INFO_KHR, .pNext = nullptr, .flags = 0, .timeout = timeout };
+    auto status = device.dispatch().acquire_profiling_lock( device.native(), &info );
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::DEVICE, "profiling lock" );
+    }
+}
+
+performance_query::profiling_lock::~profiling_lock() { device_.dispatch().release_profiling_lock( device_.native() ); }
+
+std::vector< performance_query::counter > performance_query::enumerate( physical_device const physical_device,
+                                                                        device::queue::family::id_type const family_index )
+{
+    auto const& dispatch = physical_device.dispatch();
+    if( nullptr == dispatch.enumerate_queue_family_performance_query_counters )
+    {
+        return {};
+    }
+
+    uint32_t count = 0;
+    auto status = dispatch.enumerate_queue_family_performance_query_counters( physical_device.native(), family_index, &count, nullptr, nullptr );
+    if( VK_SUCCESS != status )
+    {
+        return {};
+    }
+
+    std::vector< VkPerformanceCounterKHR > properties( count, VkPerformanceCounterKHR{ .sType = VK_STRUCTURE_TYPE_PERFORMANCE_COUNTER_KHR } );
+    std::vector< VkPerformanceCounterDescriptionKHR > descriptions(
+        count, VkPerformanceCounterDescriptionKHR{ .sType = VK_STRUCTURE_TYPE_PERFORMANCE_COUNTER_DESCRIPTION_KHR } );
+    status = dispatch.enumerate_queue_family_performance_query_counters( physical_device.native(), family_index, &count, properties.data(),
+                                                                         descriptions.data() );
+    if( VK_SUCCESS != status && VK_INCOMPLETE != status )
+    {
+        throw exception( status, dbg::object::PHYSICAL_DEVICE, "performance counter enumeration" );
+    }
+
+    std::vector< counter > result;
+    result.reserve( count );
+    for( uint32_t ic = 0; ic < count; ++ic )
+    {
+        result.push_back( counter{ ic, properties[ ic ], descriptions[ ic ] } );
+    }
+    return result;
+}
+
+performance_query::performance_query( device const& device, physical_device const physical_device, device::queue::family::id_type const family_index,
+                                      std::span< uint32_t const > const counter_indices )
+    : counter_count_( counter_indices.size() )
+{
+    VkQueryPoolPerformanceCreateInfoKHR performance_info{ .sType = VK_STRUCTURE_TYPE_QUERY_POOL_PERFORMANCE_CREATE_INFO_KHR,
+                                                          .pNext = nullptr,
+                                                          .queueFamilyIndex = family_index,
+                                                          .counterIndexCount = static_cast< uint32_t >( counter_indices.size() ),
+                                                          .pCounterIndices = counter_indices.data() };
+    auto const& dispatch = physical_device.dispatch();
+    if( nullptr == dispatch.get_queue_family_performance_query_passes )
+    {
+        throw exception( result::ERROR_EXTENSION_NOT_PRESENT, dbg::object::QUERY_POOL, "performance query" );
+    }
+    dispatch.get_queue_family_performance_query_passes( physical_device.native(), &performance_info, &passes_ );
+
+    pool_ = query_pool( device, VkQueryPoolCreateInfo{ .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                                                       .pNext = &performance_info,
+                                                       .flags = 0,
+                                                       .queryType = VK_QUERY_TYPE_PERFORMANCE_QUERY_KHR,
+                                                       .queryCount = 1,
+                                                       .pipelineStatistics = 0 } );
+}
+
+expected<> performance_query::try_results( std::span< VkPerformanceCounterResultKHR > const results ) const noexcept
+{
+    assert( counter_count_ <= results.size() );
+    // performance queries take neither the availability nor the 64 bit flag, every counter has its own storage type
+    return pool_.try_results( 0, 1, std::as_writable_bytes( results.first( counter_count_ ) ), counter_count_ * sizeof( VkPerformanceCounterResultKHR ), 0 );
+}
+
+} // namespace vkcpp
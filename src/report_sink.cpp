@@ -0,0 +1,191 @@
+#include <vkcpp/report_sink.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace vkcpp
+{
+namespace dbg
+{
+async_sink::async_sink( callback_type target, void* const puser, size_t const capacity, std::chrono::milliseconds const dedup_window,
+                        uint32_t const max_rate )
+    : target_( std::move( target ) )
+    , puser_data_( puser )
+    , dedup_window_( dedup_window )
+    , max_rate_( max_rate )
+    , ring_( capacity )
+    , tokens_( static_cast< double >( max_rate ) )
+    , refilled_( std::chrono::steady_clock::now() )
+{
+    thread_ = std::jthread( [ this ]( std::stop_token stop ) { drain( std::move( stop ) ); } );
+}
+
+async_sink::~async_sink()
+{
+    thread_.request_stop();
+    signal_.fetch_add( 1, std::memory_order_release );
+    signal_.notify_one();
+    thread_.join();
+}
+
+callback_type async_sink::callback()
+{
+    return [ this ]( flag const flag, object const object, unsigned long long const object_id, int const location, int const message_code,
+                     std::string_view const layer_prefix, std::string_view const message, void* )
+    {
+        push( flag, object, object_id, location, message_code, layer_prefix, message );
+        return false;
+    };
+}
+
+bool async_sink::push( flag const flag, object const object, unsigned long long const object_id, int const location, int const message_code,
+                       std::string_view const prefix, std::string_view const text ) noexcept
+{
+    received_.fetch_add( 1, std::memory_order_relaxed );
+    auto const queued = ring_.try_push(
+        [ & ]( message& payload ) noexcept
+        {
+            payload.report_flag = flag;
+            payload.object_type = object;
+            payload.object_id = object_id;
+            payload.location = location;
+            payload.message_code = message_code;
+            payload.prefix_size = static_cast< uint32_t >( std::min( prefix.size(), max_prefix_size ) );
+            std::memcpy( payload.prefix.data(), prefix.data(), payload.prefix_size );
+            payload.message_size = static_cast< uint32_t >( std::min( text.size(), max_message_size ) );
+            std::memcpy( payload.text.data(), text.data(), payload.message_size );
+        } );
+    if( !queued )
+    {
+        // the ring still holds the messages of the previous lap
+        dropped_.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    queued_.fetch_add( 1, std::memory_order_release );
+    signal_.fetch_add( 1, std::memory_order_release );
+    signal_.notify_one();
+    return true;
+}
+
+bool async_sink::pop( message& payload ) noexcept
+{
+    return ring_.try_pop( [ & ]( message const& source ) { payload = source; } );
+}
+
+void async_sink::drain( std::stop_token const stop )
+{
+    auto payload = std::make_unique< message >();
+    for( ;; )
+    {
+        auto const seen = signal_.load( std::memory_order_acquire );
+        while( pop( *payload ) )
+        {
+            handle( *payload );
+            handled_.fetch_add( 1, std::memory_order_release );
+            handled_.notify_all();
+        }
+        if( stop.stop_requested() )
+        {
+            return;
+        }
+        signal_.wait( seen, std::memory_order_acquire );
+    }
+}
+
+void async_sink::handle( message const& payload )
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    std::string_view const text( payload.text.data(), payload.message_size );
+    if( flag::PERF == payload.report_flag )
+    {
+        auto& counter = perf_counters_[ payload.message_code ];
+        counter.message_code = payload.message_code;
+        ++counter.count;
+        counter.last_message.assign( text );
+        return;
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    auto const [ irepeat, inserted ] = repeats_.try_emplace( std::make_pair( payload.message_code, payload.object_id ), repeat{ now, 0 } );
+    if( !inserted && now - irepeat->second.delivered < dedup_window_ )
+    {
+        ++irepeat->second.suppressed;
+        ++stats_.duplicates;
+        return;
+    }
+
+    if( 0 < max_rate_ )
+    {
+        auto const elapsed = std::chrono::duration< double >( now - refilled_ ).count();
+        tokens_ = std::min( static_cast< double >( max_rate_ ), tokens_ + elapsed * max_rate_ );
+        refilled_ = now;
+        if( 1.0 > tokens_ )
+        {
+            ++stats_.rate_limited;
+            if( inserted )
+            {
+                repeats_.erase( irepeat );
+            }
+            return;
+        }
+        tokens_ -= 1.0;
+    }
+
+    auto const suppressed = std::exchange( irepeat->second.suppressed, 0 );
+    irepeat->second.delivered = now;
+    ++stats_.delivered;
+    if( 4096 < repeats_.size() )
+    {
+        // messages not seen for a whole window would be delivered again anyway
+        std::erase_if( repeats_, [ & ]( auto const& entry ) { return dedup_window_ <= now - entry.second.delivered; } );
+    }
+    lock.unlock();
+
+    std::string_view const prefix( payload.prefix.data(), payload.prefix_size );
+    if( 0 == suppressed )
+    {
+        target_( payload.report_flag, payload.object_type, payload.object_id, payload.location, payload.message_code, prefix, text, puser_data_ );
+    }
+    else
+    {
+        auto const annotated = std::string( text ) + " [repeated " + std::to_string( suppressed ) + " times]";
+        target_( payload.report_flag, payload.object_type, payload.object_id, payload.location, payload.message_code, prefix, annotated, puser_data_ );
+    }
+}
+
+void async_sink::flush()
+{
+    auto const target = queued_.load( std::memory_order_acquire );
+    for( auto handled = handled_.load( std::memory_order_acquire ); handled < target; handled = handled_.load( std::memory_order_acquire ) )
+    {
+        handled_.wait( handled, std::memory_order_acquire );
+    }
+}
+
+async_sink::statistics async_sink::stats() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    auto result = stats_;
+    result.received = received_.load( std::memory_order_relaxed );
+    result.dropped = dropped_.load( std::memory_order_relaxed );
+    return result;
+}
+
+std::vector< async_sink::perf_counter > async_sink::perf_counters() const
+{
+    std::vector< perf_counter > result;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        result.reserve( perf_counters_.size() );
+        for( auto const& ic: perf_counters_ )
+        {
+            result.push_back( ic.second );
+        }
+    }
+    std::sort( result.begin(), result.end(), []( auto const& a, auto const& b ) { return a.message_code < b.message_code; } );
+    return result;
+}
+
+} // namespace dbg
+} // namespace vkcpp
@@ -0,0 +1,144 @@
+#include <vkcpp/scheduler.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace vkcpp
+{
+task_scheduler::task_scheduler( size_t const thread_count )
+{
+    auto const count = std::max( thread_count, size_t( 1 ) );
+    queues_.reserve( count );
+    for( size_t iq = 0; iq < count; ++iq )
+    {
+        queues_.push_back( std::make_unique< work_queue >() );
+    }
+    // queue 0 belongs to the thread calling parallel_for
+    workers_.reserve( count - 1 );
+    for( size_t iw = 1; iw < count; ++iw )
+    {
+        workers_.emplace_back( [ this, iw ]( std::stop_token const& stop ) { run( stop, iw ); } );
+    }
+}
+
+task_scheduler::~task_scheduler()
+{
+    for( auto& iw: workers_ )
+    {
+        iw.request_stop();
+    }
+    start_.notify_all();
+}
+
+void task_scheduler::parallel_for( size_t const count, task_type const& task )
+{
+    if( 0 == count )
+    {
+        return;
+    }
+
+    std::lock_guard< std::mutex > run_lock( run_mutex_ );
+    ptask_.store( &task, std::memory_order_relaxed );
+    remaining_.store( count, std::memory_order_relaxed );
+
+    auto const block_size = ( count + queues_.size() - 1 ) / queues_.size();
+    for( size_t iq = 0; iq < queues_.size(); ++iq )
+    {
+        auto& queue = *queues_[ iq ];
+        std::lock_guard< std::mutex > lock( queue.mutex );
+        for( auto ii = iq * block_size; ii < std::min( count, ( iq + 1 ) * block_size ); ++ii )
+        {
+            queue.indices.push_back( ii );
+        }
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        ++generation_;
+    }
+    start_.notify_all();
+
+    while( try_run( 0 ) )
+    {
+    }
+
+    std::unique_lock< std::mutex > lock( mutex_ );
+    done_.wait( lock, [ this ]() { return 0 == remaining_.load( std::memory_order_acquire ); } );
+    if( error_ )
+    {
+        std::rethrow_exception( std::exchange( error_, nullptr ) );
+    }
+}
+
+bool task_scheduler::try_run( size_t const self )
+{
+    size_t index = 0;
+    bool found = false;
+    {
+        auto& own = *queues_[ self ];
+        std::lock_guard< std::mutex > lock( own.mutex );
+        if( !own.indices.empty() )
+        {
+            index = own.indices.front();
+            own.indices.pop_front();
+            found = true;
+        }
+    }
+    for( size_t iq = 1; !found && iq < queues_.size(); ++iq )
+    {
+        auto& victim = *queues_[ ( self + iq ) % queues_.size() ];
+        std::lock_guard< std::mutex > lock( victim.mutex );
+        if( !victim.indices.empty() )
+        {
+            index = victim.indices.back();
+            victim.indices.pop_back();
+            found = true;
+        }
+    }
+    if( !found )
+    {
+        return false;
+    }
+
+    try
+    {
+        ( *ptask_.load( std::memory_order_relaxed ) )( index );
+    }
+    catch( ... )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if( !error_ )
+        {
+            error_ = std::current_exception();
+        }
+    }
+
+    if( 1 == remaining_.fetch_sub( 1, std::memory_order_acq_rel ) )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        done_.notify_all();
+    }
+    return true;
+}
+
+void task_scheduler::run( std::stop_token const& stop, size_t const self )
+{
+    uint64_t seen = 0;
+    while( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            start_.wait( lock, stop, [ & ]() { return generation_ != seen; } );
+            if( stop.stop_requested() )
+            {
+                return;
+            }
+            seen = generation_;
+        }
+        while( try_run( self ) )
+        {
+        }
+    }
+}
+
+} // namespace vkcpp
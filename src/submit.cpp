@@ -0,0 +1,471 @@
+#include <vkcpp/submit.hpp>
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace
+{
+void complete( vkcpp::queue_submitter::completion_type const& completion, VkResult const status ) noexcept
+{
+    try
+    {
+        completion( status );
+    }
+    catch( ... )
+    {
+        // the submitter thread has to keep going for every other submission
+    }
+}
+
+} // namespace
+
+namespace vkcpp
+{
+namespace private_
+{
+void submission_batch::append( submission const& work )
+{
+    assert( work.wait_stages.size() == work.wait_semaphores.size() );
+    assert( work.wait_values.empty() || work.wait_values.size() == work.wait_semaphores.size() );
+    assert( work.signal_values.empty() || work.signal_values.size() == work.signal_semaphores.size() );
+
+    if( entries.empty() )
+    {
+        oldest = std::chrono::steady_clock::now();
+    }
+
+    entry next{ .command_buffer_offset = static_cast< uint32_t >( command_buffers.size() ),
+                .command_buffer_count = static_cast< uint32_t >( work.command_buffers.size() ),
+                .wait_offset = static_cast< uint32_t >( semaphores.size() ),
+                .wait_count = static_cast< uint32_t >( work.wait_semaphores.size() ),
+                .signal_offset = static_cast< uint32_t >( semaphores.size() + work.wait_semaphores.size() ),
+                .signal_count = static_cast< uint32_t >( work.signal_semaphores.size() ),
+                .timeline = !work.wait_values.empty() || !work.signal_values.empty(),
+                .fence = work.fence };
+
+    command_buffers.insert( command_buffers.end(), work.command_buffers.begin(), work.command_buffers.end() );
+    semaphores.insert( semaphores.end(), work.wait_semaphores.begin(), work.wait_semaphores.end() );
+    semaphores.insert( semaphores.end(), work.signal_semaphores.begin(), work.signal_semaphores.end() );
+    stages.insert( stages.end(), work.wait_stages.begin(), work.wait_stages.end() );
+    stages.resize( semaphores.size(), 0 );
+
+    if( work.wait_values.empty() )
+    {
+        values.resize( values.size() + work.wait_semaphores.size(), 0 );
+    }
+    values.insert( values.end(), work.wait_values.begin(), work.wait_values.end() );
+    if( work.signal_values.empty() )
+    {
+        values.resize( values.size() + work.signal_semaphores.size(), 0 );
+    }
+    values.insert( values.end(), work.signal_values.begin(), work.signal_values.end() );
+
+    entries.push_back( next );
+}
+
+void submission_batch::clear() noexcept
+{
+    entries.clear();
+    command_buffers.clear();
+    semaphores.clear();
+    stages.clear();
+    values.clear();
+    infos.clear();
+    timeline_infos.clear();
+}
+
+void submission_batch::submit( device::queue const& queue, VkFence const tail_fence )
+{
+    infos.reserve( entries.size() );
+    timeline_infos.reserve( entries.size() );
+    for( auto const& ie: entries )
+    {
+        VkSubmitInfo info{ .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                           .pNext = nullptr,
+                           .waitSemaphoreCount = ie.wait_count,
+                           .pWaitSemaphores = semaphores.data() + ie.wait_offset,
+                           .pWaitDstStageMask = stages.data() + ie.wait_offset,
+                           .commandBufferCount = ie.command_buffer_count,
+                           .pCommandBuffers = command_buffers.data() + ie.command_buffer_offset,
+                           .signalSemaphoreCount = ie.signal_count,
+                           .pSignalSemaphores = semaphores.data() + ie.signal_offset };
+        if( ie.timeline )
+        {
+            timeline_infos.push_back( VkTimelineSemaphoreSubmitInfo{ .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                                                                     .pNext = nullptr,
+                                                                     .waitSemaphoreValueCount = ie.wait_count,
+                                                                     .pWaitSemaphoreValues = values.data() + ie.wait_offset,
+                                                                     .signalSemaphoreValueCount = ie.signal_count,
+                                                                     .pSignalSemaphoreValues = values.data() + ie.signal_offset } );
+            info.pNext = &timeline_infos.back();
+        }
+        infos.push_back( info );
+    }
+
+    try
+    {
+        size_t first = 0;
+        for( size_t ie = 0; ie < entries.size(); ++ie )
+        {
+            auto const last = ie + 1 == entries.size();
+            if( VK_NULL_HANDLE != entries[ ie ].fence || last )
+            {
+                auto const fence = VK_NULL_HANDLE != entries[ ie ].fence ? entries[ ie ].fence : tail_fence;
+                queue.submit( std::span< VkSubmitInfo const >( infos.data() + first, ie + 1 - first ), fence );
+                first = ie + 1;
+            }
+        }
+        // an empty submission still signals its fence once all earlier work on the queue is done
+        if( VK_NULL_HANDLE != tail_fence && ( entries.empty() || VK_NULL_HANDLE != entries.back().fence ) )
+        {
+            queue.submit( std::span< VkSubmitInfo const >(), tail_fence );
+        }
+    }
+    catch( exception const& )
+    {
+        clear();
+        throw;
+    }
+    clear();
+}
+
+} // namespace private_
+
+submission_batcher::submission_batcher( device::queue queue, size_t const max_batch_size, std::chrono::nanoseconds const deadline )
+    : queue_( queue )
+    , max_batch_size_( std::max( max_batch_size, size_t( 1 ) ) )
+    , deadline_( deadline )
+{
+    if( std::chrono::nanoseconds::zero() < deadline_ )
+    {
+        thread_ = std::jthread( [ this ]( std::stop_token const& stop ) { run( stop ); } );
+    }
+}
+
+submission_batcher::~submission_batcher()
+{
+    if( thread_.joinable() )
+    {
+        thread_.request_stop();
+        thread_.join();
+    }
+    try
+    {
+        flush_impl();
+    }
+    catch( exception const& )
+    {
+        // nothing left to report to at this point
+    }
+}
+
+void submission_batcher::add( submission const& work )
+{
+    throw_deferred();
+    bool full = false;
+    bool first = false;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        first = pending_.entries.empty();
+        pending_.append( work );
+        full = max_batch_size_ <= pending_.entries.size();
+    }
+    if( full )
+    {
+        flush_impl();
+    }
+    else if( first && thread_.joinable() )
+    {
+        condition_.notify_one();
+    }
+}
+
+void submission_batcher::flush()
+{
+    throw_deferred();
+    flush_impl();
+}
+
+size_t submission_batcher::pending() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return pending_.entries.size();
+}
+
+void submission_batcher::flush_impl()
+{
+    // submit_mutex_ keeps the queue externally synchronised and batches in order, producers only wait on mutex_
+    std::lock_guard< std::mutex > submit_lock( submit_mutex_ );
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if( pending_.entries.empty() )
+        {
+            return;
+        }
+        std::swap( pending_, spare_ );
+    }
+    spare_.submit( queue_ );
+}
+
+void submission_batcher::throw_deferred()
+{
+    VkResult status = VK_SUCCESS;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        std::swap( status, deferred_status_ );
+    }
+    if( VK_SUCCESS != status )
+    {
+        throw exception( status, dbg::object::QUEUE, "deferred submission" );
+    }
+}
+
+void submission_batcher::run( std::stop_token const& stop )
+{
+    while( !stop.stop_requested() )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            if( !condition_.wait( lock, stop, [ this ]() { return !pending_.entries.empty(); } ) )
+            {
+                return;
+            }
+            // the batch may be flushed for size meanwhile, so keep following whichever submission is oldest now
+            while( !pending_.entries.empty() && std::chrono::steady_clock::now() < pending_.oldest + deadline_ )
+            {
+                condition_.wait_until( lock, stop, pending_.oldest + deadline_, []() { return false; } );
+                if( stop.stop_requested() )
+                {
+                    return;
+                }
+            }
+        }
+
+        try
+        {
+            flush_impl();
+        }
+        catch( exception const& ex )
+        {
+            // surfaced to the next producer calling add or flush
+            std::lock_guard< std::mutex > lock( mutex_ );
+            deferred_status_ = static_cast< VkResult >( ex.result );
+        }
+    }
+}
+
+queue_submitter::job::job( submission const& work, completion_type&& i_completion )
+    : command_buffers( work.command_buffers.begin(), work.command_buffers.end() )
+    , wait_semaphores( work.wait_semaphores.begin(), work.wait_semaphores.end() )
+    , wait_stages( work.wait_stages.begin(), work.wait_stages.end() )
+    , wait_values( work.wait_values.begin(), work.wait_values.end() )
+    , signal_semaphores( work.signal_semaphores.begin(), work.signal_semaphores.end() )
+    , signal_values( work.signal_values.begin(), work.signal_values.end() )
+    , fence( work.fence )
+    , completion( std::move( i_completion ) )
+{}
+
+void queue_submitter::job::swap( job& other ) noexcept
+{
+    command_buffers.swap( other.command_buffers );
+    wait_semaphores.swap( other.wait_semaphores );
+    wait_stages.swap( other.wait_stages );
+    wait_values.swap( other.wait_values );
+    signal_semaphores.swap( other.signal_semaphores );
+    signal_values.swap( other.signal_values );
+    std::swap( fence, other.fence );
+    completion.swap( other.completion );
+}
+
+submission queue_submitter::job::view() const noexcept
+{
+    return submission{ .command_buffers = command_buffers,
+                       .wait_semaphores = wait_semaphores,
+                       .wait_stages = wait_stages,
+                       .wait_values = wait_values,
+                       .signal_semaphores = signal_semaphores,
+                       .signal_values = signal_values,
+                       .fence = fence };
+}
+
+queue_submitter::queue_submitter( device const& device, device::queue queue, size_t const capacity, size_t const max_batch_size,
+                                  std::chrono::nanoseconds const poll_interval )
+    : device_( device.native() )
+    , queue_( queue )
+    , max_batch_size_( std::max( max_batch_size, size_t( 1 ) ) )
+    , poll_interval_( poll_interval )
+    , fences_( device )
+    , ring_( capacity )
+    , thread_( [ this ]( std::stop_token const& stop ) { run( stop ); } )
+{}
+
+queue_submitter::~queue_submitter()
+{
+    // the submitter drains the ring and waits for everything in flight before it returns
+    thread_.request_stop();
+    wake();
+    thread_.join();
+}
+
+void queue_submitter::wake() noexcept
+{
+    wake_.fetch_add( 1, std::memory_order_release );
+    wake_.notify_one();
+}
+
+void queue_submitter::submit( submission const& work, completion_type completion )
+{
+    assert( !thread_.get_stop_token().stop_requested() );
+    // the copy is made before a slot is claimed, a claimed slot holds up the submitter until it is filled
+    job next( work, std::move( completion ) );
+    // a full ring only waits for the submitter to catch up, it never blocks on a lock
+    while( !ring_.try_push( [ & ]( job& slot ) noexcept { slot.swap( next ); } ) )
+    {
+        wake();
+        std::this_thread::yield();
+    }
+    wake();
+}
+
+std::future< void > queue_submitter::submit( submission const& work )
+{
+    auto promise = std::make_shared< std::promise< void > >();
+    auto result = promise->get_future();
+    submit( work, [ promise ]( VkResult const status ) {
+        if( VK_SUCCESS == status )
+        {
+            promise->set_value();
+            return;
+        }
+        promise->set_exception( std::make_exception_ptr( exception( status, dbg::object::QUEUE, "submission" ) ) );
+    } );
+    return result;
+}
+
+size_t queue_submitter::drain()
+{
+    size_t count = 0;
+    VkResult status = VK_SUCCESS;
+    bool tracked = false;
+    try
+    {
+        while( count < max_batch_size_ && ring_.try_pop( [ this ]( job& slot ) noexcept { current_.swap( slot ); } ) )
+        {
+            ++count;
+            // the completion is taken first, so a batch that fails to build still reaches every job in it
+            completions_.emplace_back().swap( current_.completion );
+            batch_.append( current_.view() );
+        }
+        if( 0 == count )
+        {
+            return 0;
+        }
+
+        in_flight_.emplace_back();
+        tracked = true;
+        if( VK_NULL_HANDLE == fence_ )
+        {
+            fence_ = fences_.acquire();
+        }
+        batch_.submit( queue_, fence_ );
+    }
+    catch( exception const& ex )
+    {
+        status = static_cast< VkResult >( ex.result );
+    }
+    catch( std::bad_alloc const& )
+    {
+        status = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if( VK_SUCCESS != status )
+    {
+        if( tracked )
+        {
+            in_flight_.pop_back();
+        }
+        fail( status );
+        return count;
+    }
+    in_flight_.back().fence = std::exchange( fence_, VK_NULL_HANDLE );
+    in_flight_.back().completions.swap( completions_ );
+    return count;
+}
+
+void queue_submitter::fail( VkResult const status ) noexcept
+{
+    batch_.clear();
+    for( auto const& ic: completions_ )
+    {
+        complete( ic, status );
+    }
+    completions_.clear();
+}
+
+void queue_submitter::retire( bool const block )
+{
+    auto const& dispatch = queue_.dispatch();
+    while( !in_flight_.empty() )
+    {
+        auto& oldest = in_flight_.front();
+        if( block )
+        {
+            dispatch.wait_for_fences( device_, 1, &oldest.fence, VK_TRUE, UINT64_MAX );
+        }
+        auto const status = dispatch.get_fence_status( device_, oldest.fence );
+        if( VK_NOT_READY == status )
+        {
+            return;
+        }
+        auto const done = std::move( oldest );
+        in_flight_.pop_front();
+        for( auto const& ic: done.completions )
+        {
+            complete( ic, status );
+        }
+        try
+        {
+            fences_.release( done.fence );
+        }
+        catch( std::bad_alloc const& )
+        {
+            // the pool still destroys the fence, it is only not reused
+        }
+    }
+}
+
+void queue_submitter::run( std::stop_token const& stop )
+{
+    while( true )
+    {
+        auto const seen = wake_.load( std::memory_order_acquire );
+        auto const drained = drain();
+        retire( false );
+
+        if( max_batch_size_ == drained )
+        {
+            continue;
+        }
+        if( ring_.empty() )
+        {
+            if( stop.stop_requested() )
+            {
+                break;
+            }
+            if( in_flight_.empty() )
+            {
+                wake_.wait( seen, std::memory_order_acquire );
+            }
+            else
+            {
+                // new work only waits one poll interval behind the oldest batch in flight
+                auto const fence = in_flight_.front().fence;
+                queue_.dispatch().wait_for_fences( device_, 1, &fence, VK_TRUE, static_cast< uint64_t >( poll_interval_.count() ) );
+            }
+        }
+    }
+    retire( true );
+}
+
+} // namespace vkcpp
@@ -0,0 +1,222 @@
+#include <vkcpp/sync.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace vkcpp
+{
+fence_pool::fence_pool( device const& device, size_t const initial_count )
+    : device_( device.native() )
+    , pdispatch_( device.pdispatch() )
+{
+    assert( device );
+    free_.reserve( initial_count );
+    for( size_t iif = 0; iif < initial_count; ++iif )
+    {
+        free_.push_back( create() );
+    }
+}
+
+fence_pool::~fence_pool()
+{
+    for( auto const fence: created_ )
+    {
+        pdispatch_->destroy_fence( device_, fence, pdispatch_->allocation_callbacks );
+    }
+}
+
+VkFence fence_pool::create()
+{
+    VkFenceCreateInfo info{ .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, .pNext = nullptr, .flags = 0 };
+    VkFence result = VK_NULL_HANDLE;
+    // room first, so a fence is never made that could not be kept track of
+    created_.reserve( created_.size() + 1 );
+    auto status = pdispatch_->create_fence( device_, &info, pdispatch_->allocation_callbacks, &result );
+    if( VK_SUCCESS == status )
+    {
+        created_.push_back( result );
+        return result;
+    }
+    throw exception( status, dbg::object::FENCE, "creation" );
+}
+
+VkFence fence_pool::acquire()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if( free_.empty() )
+    {
+        recycle_impl();
+    }
+    if( free_.empty() )
+    {
+        return create();
+    }
+    auto const result = free_.back();
+    free_.pop_back();
+    return result;
+}
+
+void fence_pool::release( VkFence const fence, bool const submitted )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    ( submitted ? pending_ : free_ ).push_back( fence );
+}
+
+size_t fence_pool::recycle()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return recycle_impl();
+}
+
+size_t fence_pool::recycle_impl()
+{
+    signaled_.clear();
+    std::erase_if( pending_, [ this ]( VkFence const fence ) {
+        if( VK_SUCCESS == pdispatch_->get_fence_status( device_, fence ) )
+        {
+            signaled_.push_back( fence );
+            return true;
+        }
+        return false;
+    } );
+
+    if( signaled_.empty() )
+    {
+        return 0;
+    }
+
+    auto status = pdispatch_->reset_fences( device_, static_cast< uint32_t >( signaled_.size() ), signaled_.data() );
+    if( VK_SUCCESS != status )
+    {
+        pending_.insert( pending_.end(), signaled_.begin(), signaled_.end() );
+        throw exception( status, dbg::object::FENCE, "reset" );
+    }
+    free_.insert( free_.end(), signaled_.begin(), signaled_.end() );
+    return signaled_.size();
+}
+
+size_t fence_pool::size() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return created_.size();
+}
+
+size_t fence_pool::available() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return free_.size();
+}
+
+wait_policy::wait_policy( mode const wait_mode, std::chrono::nanoseconds const spin_budget )
+    : mode_( wait_mode )
+    , max_spin_( std::max( spin_budget, std::chrono::nanoseconds::zero() ) )
+    // start out assuming short jobs, a first long wait moves the average past the budget quickly enough
+    , average_wait_( max_spin_.count() / 4 )
+{}
+
+std::chrono::nanoseconds wait_policy::spin_budget() const noexcept
+{
+    switch( mode_ )
+    {
+    case mode::SPIN_THEN_BLOCK:
+        return max_spin_;
+    case mode::ADAPTIVE:
+    {
+        // twice the average covers most of the spread of short jobs, longer ones are not worth burning a core for
+        auto const spin = std::chrono::nanoseconds( 2 * average_wait_.load( std::memory_order_relaxed ) );
+        return spin <= max_spin_ ? spin : std::chrono::nanoseconds::zero();
+    }
+    default:
+        return std::chrono::nanoseconds::zero();
+    }
+}
+
+void wait_policy::observe( std::chrono::nanoseconds const elapsed ) noexcept
+{
+    if( mode::ADAPTIVE != mode_ )
+    {
+        return;
+    }
+    // racing waiters may lose an update, which only slows the average down a little
+    auto const average = average_wait_.load( std::memory_order_relaxed );
+    average_wait_.store( average + ( elapsed.count() - average ) / 8, std::memory_order_relaxed );
+}
+
+expected<> wait_policy::try_wait( VkDevice const device, private_::device_dispatch const& dispatch, std::span< VkFence const > const fences,
+                                  unsigned long long const timeout ) noexcept
+{
+    private_::call_scope const call( api_call::WAIT_FOR_FENCES );
+    private_::trace_scope const scope( "vkWaitForFences" );
+    auto const start = std::chrono::steady_clock::now();
+    auto spin = spin_budget();
+    if( timeout < static_cast< unsigned long long >( spin.count() ) )
+    {
+        spin = std::chrono::nanoseconds( timeout );
+    }
+    if( std::chrono::nanoseconds::zero() < spin )
+    {
+        // fences stay signaled until reset, so the ones already seen signaled are not asked again
+        size_t signaled_count = 0;
+        do
+        {
+            while( signaled_count < fences.size() )
+            {
+                auto const status = dispatch.get_fence_status( device, fences[ signaled_count ] );
+                if( VK_NOT_READY == status )
+                {
+                    break;
+                }
+                if( VK_SUCCESS != status )
+                {
+                    return error{ static_cast< result >( status ), dbg::object::FENCE, "status query" };
+                }
+                ++signaled_count;
+            }
+            if( fences.size() == signaled_count )
+            {
+                observe( std::chrono::steady_clock::now() - start );
+                return {};
+            }
+        } while( std::chrono::steady_clock::now() - start < spin );
+    }
+
+    auto const spent = static_cast< unsigned long long >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count() );
+    auto const status = dispatch.wait_for_fences( device, static_cast< uint32_t >( fences.size() ), fences.data(), VK_TRUE, timeout > spent ? timeout - spent : 0 );
+    if( VK_SUCCESS == status )
+    {
+        observe( std::chrono::steady_clock::now() - start );
+    }
+    return private_::check( status, dbg::object::FENCE, "waiting" );
+}
+
+VkResult retirement_point::status( device_reference const device, uint64_t const timeout ) const noexcept
+{
+    auto status = VK_SUCCESS;
+    if( VK_NULL_HANDLE != fence )
+    {
+        status = device.dispatch().wait_for_fences( device.native(), 1, &fence, VK_TRUE, timeout );
+    }
+    else if( VK_NULL_HANDLE != timeline )
+    {
+        VkSemaphoreWaitInfo info{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                                  .pNext = nullptr,
+                                  .flags = 0,
+                                  .semaphoreCount = 1,
+                                  .pSemaphores = &timeline,
+                                  .pValues = &value };
+        status = device.dispatch().wait_semaphores( device.native(), &info, timeout );
+    }
+    return VK_ERROR_DEVICE_LOST == status ? VK_SUCCESS : status;
+}
+
+bool retirement_point::passed( device_reference const device, uint64_t const timeout ) const
+{
+    auto const result = status( device, timeout );
+    if( VK_SUCCESS != result && VK_TIMEOUT != result )
+    {
+        throw exception( result, VK_NULL_HANDLE != fence ? dbg::object::FENCE : dbg::object::SEMAPHORE, "retirement check" );
+    }
+    return VK_SUCCESS == result;
+}
+
+} // namespace vkcpp
@@ -0,0 +1,492 @@
+#include <vkcpp/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <ostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+// the host domain calibrated timestamps are taken in, trace_clock() reads the same clock
+constexpr VkTimeDomainEXT const host_domain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+
+int64_t host_nanoseconds( int64_t const ticks ) noexcept
+{
+    static int64_t const frequency = []
+    {
+        LARGE_INTEGER result;
+        QueryPerformanceFrequency( &result );
+        return result.QuadPart;
+    }();
+    // split so ticks times a billion does not overflow
+    return ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency;
+}
+#else
+constexpr VkTimeDomainEXT const host_domain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+
+int64_t host_nanoseconds( int64_t const nanoseconds ) noexcept { return nanoseconds; }
+#endif
+
+// asking for a time domain the device does not list is invalid usage
+bool calibratable( vkcpp::device const& device, vkcpp::physical_device const physical_device )
+{
+    auto const query = physical_device.dispatch().get_physical_device_calibrateable_time_domains;
+    if( nullptr == device.dispatch().get_calibrated_timestamps || nullptr == query )
+    {
+        return false;
+    }
+    uint32_t count = 0;
+    if( VK_SUCCESS != query( physical_device.native(), &count, nullptr ) )
+    {
+        return false;
+    }
+    std::vector< VkTimeDomainEXT > domains( count );
+    if( 0 > query( physical_device.native(), &count, domains.data() ) )
+    {
+        return false;
+    }
+    domains.resize( count );
+    auto const listed = [ & ]( VkTimeDomainEXT const domain ) { return std::find( domains.begin(), domains.end(), domain ) != domains.end(); };
+    return listed( VK_TIME_DOMAIN_DEVICE_EXT ) && listed( host_domain );
+}
+
+struct thread_ring
+{
+    static constexpr size_t const capacity = 4096;
+
+    struct event
+    {
+        char const* name;
+        int64_t begin;
+        int64_t end;
+    };
+
+    uint32_t thread;
+    std::array< event, capacity > events;
+    // head is only written by the owning thread, tail only by the draining recorder
+    std::atomic< size_t > head{ 0 };
+    std::atomic< size_t > tail{ 0 };
+    std::atomic< uint64_t > dropped{ 0 };
+};
+
+// rings stay registered after their thread ends until a recorder has drained them
+struct ring_registry
+{
+    std::mutex mutex;
+    uint32_t thread_count{ 0 };
+    std::vector< std::shared_ptr< thread_ring > > rings;
+};
+
+ring_registry& registry()
+{
+    static ring_registry instance;
+    return instance;
+}
+
+thread_ring& local_ring()
+{
+    thread_local std::shared_ptr< thread_ring > const ring = []
+    {
+        auto result = std::make_shared< thread_ring >();
+        auto& rings = registry();
+        std::lock_guard< std::mutex > lock( rings.mutex );
+        result->thread = rings.thread_count++;
+        rings.rings.push_back( result );
+        return result;
+    }();
+    return *ring;
+}
+
+void put_varint( std::string& out, uint64_t value )
+{
+    while( 0x80 <= value )
+    {
+        out.push_back( static_cast< char >( ( value & 0x7F ) | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast< char >( value ) );
+}
+
+void put_varint_field( std::string& out, uint32_t const field, uint64_t const value )
+{
+    put_varint( out, uint64_t( field ) << 3 );
+    put_varint( out, value );
+}
+
+void put_bytes_field( std::string& out, uint32_t const field, std::string_view const bytes )
+{
+    put_varint( out, ( uint64_t( field ) << 3 ) | 2 );
+    put_varint( out, bytes.size() );
+    out.append( bytes );
+}
+
+void put_json_string( std::ostream& stream, std::string_view const text )
+{
+    stream << '"';
+    for( auto const ic: text )
+    {
+        switch( ic )
+        {
+        case '"': stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        default:
+            if( static_cast< unsigned char >( ic ) < 0x20 )
+            {
+                stream << ' ';
+            }
+            else
+            {
+                stream << ic;
+            }
+        }
+    }
+    stream << '"';
+}
+
+std::string track_name( uint32_t const track ) { return 0 == track ? std::string( "GPU" ) : "CPU thread " + std::to_string( track - 1 ); }
+
+} // namespace
+
+namespace vkcpp
+{
+namespace private_
+{
+int64_t trace_clock() noexcept
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter( &counter );
+    return host_nanoseconds( counter.QuadPart );
+#else
+    timespec now{};
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return int64_t( now.tv_sec ) * 1000000000 + now.tv_nsec;
+#endif
+}
+
+void trace_event( char const* const name, int64_t const begin, int64_t const end ) noexcept
+{
+    auto& ring = local_ring();
+    auto const head = ring.head.load( std::memory_order_relaxed );
+    if( thread_ring::capacity <= head - ring.tail.load( std::memory_order_acquire ) )
+    {
+        ring.dropped.fetch_add( 1, std::memory_order_relaxed );
+        return;
+    }
+    ring.events[ head % thread_ring::capacity ] = thread_ring::event{ name, begin, end };
+    ring.head.store( head + 1, std::memory_order_release );
+}
+
+} // namespace private_
+
+trace_recorder::trace_recorder( device const& device, physical_device const physical_device )
+    : device_( device )
+    , period_( physical_device::property( physical_device ).limits.timestampPeriod )
+    , calibratable_( calibratable( device, physical_device ) )
+{}
+
+trace_recorder::~trace_recorder()
+{
+    stop();
+    for( auto* const pprofiler: profilers_ )
+    {
+        pprofiler->set_zone_listener( {} );
+    }
+}
+
+void trace_recorder::start()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    assert( !private_::tracing.load( std::memory_order_relaxed ) || recording_ );
+    collect_locked();
+    cpu_events_.clear();
+    gpu_events_.clear();
+    dropped_ = 0;
+    calibrate();
+    recording_ = true;
+    private_::tracing.store( true, std::memory_order_relaxed );
+}
+
+void trace_recorder::stop() noexcept
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if( recording_ )
+    {
+        private_::tracing.store( false, std::memory_order_relaxed );
+        recording_ = false;
+    }
+}
+
+bool trace_recorder::recording() const noexcept
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return recording_;
+}
+
+void trace_recorder::attach( profiler& profiler )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        profilers_.push_back( &profiler );
+    }
+    profiler.set_zone_listener(
+        [ this ]( std::string_view const name, uint32_t const depth, double const begin, double const end )
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if( recording_ )
+            {
+                gpu_events_.push_back( gpu_event{ std::string( name ), depth, begin, end } );
+            }
+        } );
+}
+
+void trace_recorder::calibrate()
+{
+    calibrated_ = false;
+    if( !calibratable_ )
+    {
+        return;
+    }
+
+    std::array< VkCalibratedTimestampInfoEXT, 2 > const infos{
+        VkCalibratedTimestampInfoEXT{ .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_DEVICE_EXT },
+        VkCalibratedTimestampInfoEXT{ .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = host_domain } };
+    std::array< uint64_t, 2 > timestamps{};
+    uint64_t deviation = 0;
+    if( VK_SUCCESS == device_.dispatch().get_calibrated_timestamps( device_.native(), 2, infos.data(), timestamps.data(), &deviation ) )
+    {
+        auto const host = host_nanoseconds( static_cast< int64_t >( timestamps[ 1 ] ) );
+        offset_ = static_cast< double >( host ) - static_cast< double >( timestamps[ 0 ] ) * period_;
+        calibrated_ = true;
+    }
+}
+
+void trace_recorder::collect()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    collect_locked();
+}
+
+void trace_recorder::collect_locked()
+{
+    auto& rings = registry();
+    std::lock_guard< std::mutex > lock( rings.mutex );
+    thread_count_ = rings.thread_count;
+    for( auto const& ring: rings.rings )
+    {
+        auto const tail = ring->tail.load( std::memory_order_relaxed );
+        auto const head = ring->head.load( std::memory_order_acquire );
+        for( auto ie = tail; ie < head; ++ie )
+        {
+            auto const& event = ring->events[ ie % thread_ring::capacity ];
+            cpu_events_.push_back( cpu_event{ event.name, ring->thread, event.begin, event.end } );
+        }
+        ring->tail.store( head, std::memory_order_release );
+        dropped_ += ring->dropped.exchange( 0, std::memory_order_relaxed );
+    }
+    // a ring only the registry still holds belongs to a thread that ended and has nothing more to give
+    std::erase_if( rings.rings, []( auto const& ring ) { return 1 == ring.use_count(); } );
+}
+
+uint64_t trace_recorder::dropped_events() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return dropped_;
+}
+
+std::vector< trace_recorder::slice > trace_recorder::slices() const
+{
+    std::vector< slice > result;
+    result.reserve( cpu_events_.size() + gpu_events_.size() );
+    for( auto const& event: cpu_events_ )
+    {
+        result.push_back( slice{ event.name, event.thread + 1, event.begin, event.end } );
+    }
+
+    auto offset = offset_;
+    if( !calibrated_ && !gpu_events_.empty() )
+    {
+        // nothing runs on the GPU before the first submit has been handed over
+        auto const first_gpu = std::min_element( gpu_events_.begin(), gpu_events_.end(), []( auto const& a, auto const& b ) { return a.begin < b.begin; } );
+        std::optional< int64_t > first_submit;
+        for( auto const& event: cpu_events_ )
+        {
+            if( std::string_view( event.name ) == "vkQueueSubmit" && ( !first_submit || event.end < *first_submit ) )
+            {
+                first_submit = event.end;
+            }
+        }
+        offset = static_cast< double >( first_submit.value_or( cpu_events_.empty() ? 0 : cpu_events_.front().begin ) ) - first_gpu->begin;
+    }
+    for( auto const& event: gpu_events_ )
+    {
+        result.push_back( slice{ event.name, 0, static_cast< int64_t >( event.begin + offset ), static_cast< int64_t >( event.end + offset ) } );
+    }
+
+    // by track, then outer slices before the ones they enclose; a slice overlapping the end of the enclosing one is cut
+    // there, so every track nests strictly
+    std::sort( result.begin(), result.end(),
+               []( auto const& a, auto const& b )
+               {
+                   return a.track != b.track ? a.track < b.track : a.begin != b.begin ? a.begin < b.begin : a.end > b.end;
+               } );
+    std::vector< int64_t > open_ends;
+    for( size_t is = 0; is < result.size(); ++is )
+    {
+        if( 0 == is || result[ is - 1 ].track != result[ is ].track )
+        {
+            open_ends.clear();
+        }
+        while( !open_ends.empty() && open_ends.back() <= result[ is ].begin )
+        {
+            open_ends.pop_back();
+        }
+        if( !open_ends.empty() )
+        {
+            result[ is ].end = std::min( result[ is ].end, open_ends.back() );
+        }
+        open_ends.push_back( result[ is ].end );
+    }
+    return result;
+}
+
+void trace_recorder::write_chrome_json( std::ostream& stream )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    collect_locked();
+    auto const all = slices();
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"vkcpp\"}}";
+    for( uint32_t it = 0; it <= thread_count_; ++it )
+    {
+        stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << it << ",\"args\":{\"name\":";
+        put_json_string( stream, track_name( it ) );
+        stream << "}}";
+    }
+
+    auto const flags = stream.flags();
+    stream.setf( std::ios::fixed, std::ios::floatfield );
+    auto const precision = stream.precision( 3 );
+    for( auto const& is: all )
+    {
+        stream << ",\n{\"name\":";
+        put_json_string( stream, is.name );
+        stream << ",\"cat\":\"" << ( 0 == is.track ? "gpu" : "cpu" ) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << is.track
+               << ",\"ts\":" << static_cast< double >( is.begin ) / 1000.0 << ",\"dur\":" << static_cast< double >( is.end - is.begin ) / 1000.0 << '}';
+    }
+    stream.precision( precision );
+    stream.flags( flags );
+    stream << "\n]}\n";
+}
+
+void trace_recorder::write_perfetto( std::ostream& stream )
+{
+    // field numbers of perfetto's trace.proto: Trace.packet, TracePacket, TrackDescriptor and TrackEvent
+    enum : uint32_t
+    {
+        TRACE_PACKET = 1,
+        PACKET_TIMESTAMP = 8,
+        PACKET_SEQUENCE_ID = 10,
+        PACKET_TRACK_EVENT = 11,
+        PACKET_SEQUENCE_FLAGS = 13,
+        PACKET_TRACK_DESCRIPTOR = 60,
+        DESCRIPTOR_UUID = 1,
+        DESCRIPTOR_NAME = 2,
+        EVENT_TYPE = 9,
+        EVENT_TRACK_UUID = 11,
+        EVENT_NAME = 23
+    };
+    enum : uint64_t
+    {
+        SLICE_BEGIN = 1,
+        SLICE_END = 2,
+        SEQUENCE_INCREMENTAL_STATE_CLEARED = 1
+    };
+    uint32_t const sequence_id = 1;
+
+    std::lock_guard< std::mutex > lock( mutex_ );
+    collect_locked();
+    auto const all = slices();
+
+    std::string trace;
+    std::string packet;
+    std::string body;
+    auto const emit = [ & ]( uint32_t const field )
+    {
+        put_varint_field( packet, PACKET_SEQUENCE_ID, sequence_id );
+        put_bytes_field( packet, field, body );
+        put_bytes_field( trace, TRACE_PACKET, packet );
+        packet.clear();
+        body.clear();
+    };
+
+    for( uint32_t it = 0; it <= thread_count_; ++it )
+    {
+        put_varint_field( body, DESCRIPTOR_UUID, it + 1 );
+        put_bytes_field( body, DESCRIPTOR_NAME, track_name( it ) );
+        if( 0 == it )
+        {
+            put_varint_field( packet, PACKET_SEQUENCE_FLAGS, SEQUENCE_INCREMENTAL_STATE_CLEARED );
+        }
+        emit( PACKET_TRACK_DESCRIPTOR );
+    }
+
+    // begins and ends in time order, the ends of a track's slices nested the way slices() arranged them
+    struct marker
+    {
+        int64_t time;
+        uint32_t track;
+        bool begin;
+        std::string_view name;
+    };
+    std::vector< marker > markers;
+    markers.reserve( 2 * all.size() );
+    std::vector< slice const* > open;
+    auto const close_until = [ & ]( int64_t const time )
+    {
+        while( !open.empty() && open.back()->end <= time )
+        {
+            markers.push_back( marker{ open.back()->end, open.back()->track, false, {} } );
+            open.pop_back();
+        }
+    };
+    for( size_t is = 0; is < all.size(); ++is )
+    {
+        if( 0 < is && all[ is - 1 ].track != all[ is ].track )
+        {
+            close_until( std::numeric_limits< int64_t >::max() );
+        }
+        close_until( all[ is ].begin );
+        markers.push_back( marker{ all[ is ].begin, all[ is ].track, true, all[ is ].name } );
+        open.push_back( &all[ is ] );
+    }
+    close_until( std::numeric_limits< int64_t >::max() );
+    std::stable_sort( markers.begin(), markers.end(), []( auto const& a, auto const& b ) { return a.time < b.time; } );
+
+    for( auto const& im: markers )
+    {
+        put_varint_field( body, EVENT_TYPE, im.begin ? SLICE_BEGIN : SLICE_END );
+        put_varint_field( body, EVENT_TRACK_UUID, im.track + 1 );
+        if( im.begin )
+        {
+            put_bytes_field( body, EVENT_NAME, im.name );
+        }
+        put_varint_field( packet, PACKET_TIMESTAMP, static_cast< uint64_t >( std::max( im.time, int64_t( 0 ) ) ) );
+        emit( PACKET_TRACK_EVENT );
+    }
+    stream.write( trace.data(), static_cast< std::streamsize >( trace.size() ) );
+}
+
+} // namespace vkcpp
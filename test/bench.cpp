@@ -0,0 +1,433 @@
+#include <vkcpp/elements.hpp>
+#include <vkcpp/allocator.hpp>
+#include <vkcpp/command.hpp>
+#include <vkcpp/descriptor.hpp>
+#include <vkcpp/host_allocator.hpp>
+#include <vkcpp/report_sink.hpp>
+#include <vkcpp/sync.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+constexpr unsigned const iteration_count = 1000000;
+
+template< typename function_type >
+double nanoseconds_per_call( function_type&& function, unsigned const count = iteration_count )
+{
+    auto const start = std::chrono::steady_clock::now();
+    for( unsigned ii = 0; ii < count; ++ii )
+    {
+        function();
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast< double >( std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() ) / count;
+}
+
+void report( char const* const name, double const trampoline, double const dispatch )
+{
+    std::cout << name << ": trampoline " << trampoline << " ns, dispatch " << dispatch << " ns" << std::endl;
+}
+
+// lavapipe reports itself as a CPU device; prefer it so the numbers are comparable across machines
+vkcpp::physical_device pick_device( std::vector< vkcpp::physical_device > const& devlist )
+{
+    for( auto const& id : devlist )
+    {
+        if( vkcpp::physical_device::kind::CPU == vkcpp::physical_device::property( id ).kind() )
+        {
+            return id;
+        }
+    }
+    return devlist.front();
+}
+
+void bench_dispatch( vkcpp::device const& device )
+{
+    auto const& dispatch = device.dispatch();
+
+    vkcpp::fence<> fence( device );
+    VkFence native_fence = fence.native();
+
+    report( "vkResetFences", nanoseconds_per_call( [ & ]() { vkResetFences( device.native(), 1, &native_fence ); } ),
+            nanoseconds_per_call( [ & ]() { dispatch.reset_fences( device.native(), 1, &native_fence ); } ) );
+
+    report( "vkGetFenceStatus", nanoseconds_per_call( [ & ]() { vkGetFenceStatus( device.native(), native_fence ); } ),
+            nanoseconds_per_call( [ & ]() { dispatch.get_fence_status( device.native(), native_fence ); } ) );
+
+    vkcpp::device::queue queue( device, 0, 0 );
+    report( "vkQueueWaitIdle", nanoseconds_per_call( [ & ]() { vkQueueWaitIdle( queue.native() ); } ),
+            nanoseconds_per_call( [ & ]() { queue.wait_idle(); } ) );
+}
+
+void bench_debug_lookup( vkcpp::instance const& instance )
+{
+    // the per-message lookup dbg::report used to do before the instance table existed
+    PFN_vkVoidFunction volatile sink = nullptr;
+    report( "vkDebugReportMessageEXT lookup", nanoseconds_per_call( [ & ]() { sink = vkGetInstanceProcAddr( instance.native(), "vkDebugReportMessageEXT" ); } ),
+            nanoseconds_per_call( [ & ]() { sink = reinterpret_cast< PFN_vkVoidFunction >( instance.dispatch().debug_report_message ); } ) );
+}
+
+void bench_report_sink()
+{
+    constexpr unsigned const message_count = 100000;
+
+    // what a driver thread pays per validation message: a callback that formats the message where it was raised, or a
+    // copy into the sink's ring with the formatting left to its thread
+    std::ostringstream log;
+    vkcpp::dbg::callback_type const format = [ &log ]( vkcpp::dbg::flag, vkcpp::dbg::object, unsigned long long const object_id, int, int const message_code,
+                                                       std::string_view const layer_prefix, std::string_view const message, void* )
+    {
+        log << layer_prefix << ' ' << message_code << ' ' << object_id << ": " << message << '\n';
+        return false;
+    };
+    std::string_view const message = "vkQueueSubmit(): pSubmits[0].pCommandBuffers[0] is unrecorded and contains no commands.";
+
+    unsigned long long object_id = 0;
+    auto const synchronous = nanoseconds_per_call(
+        [ & ]() { format( vkcpp::dbg::flag::WARN, vkcpp::dbg::object::COMMAND_BUFFER, ++object_id, 0, 1, "Validation", message, nullptr ); }, message_count );
+
+    vkcpp::dbg::async_sink sink( format, nullptr, 4096, std::chrono::milliseconds( 1000 ), 0 );
+    auto const queued = sink.callback();
+    auto const asynchronous = nanoseconds_per_call(
+        [ & ]() { queued( vkcpp::dbg::flag::WARN, vkcpp::dbg::object::COMMAND_BUFFER, ++object_id, 0, 1, "Validation", message, nullptr ); }, message_count );
+    sink.flush();
+    auto const stats = sink.stats();
+    std::cout << "debug report message: synchronous " << synchronous << " ns, async sink " << asynchronous << " ns (" << stats.dropped
+              << " dropped to a full ring)" << std::endl;
+}
+
+void bench_allocator( vkcpp::device const& device, vkcpp::physical_device const physical_device )
+{
+    constexpr unsigned const raw_count = 1000;
+    constexpr unsigned const sub_count = 100000;
+    constexpr VkDeviceSize const raw_size = VkDeviceSize( 64 ) << 10U;
+
+    auto const memory_flags = vkcpp::physical_device::memory_property::flags( vkcpp::physical_device::memory_property::flag::DEVICE_LOCAL );
+    vkcpp::allocator allocator( device, physical_device );
+    auto const memory_type_index = allocator.memory_property().find_memory_type_index( ~0U, memory_flags );
+
+    std::cout << "vkAllocateMemory+vkFreeMemory: "
+              << nanoseconds_per_call( [ & ]() { static_cast< void >( vkcpp::device_memory( device, raw_size, memory_type_index ) ); }, raw_count ) << " ns"
+              << std::endl;
+
+    std::mt19937 engine( 42 );
+    std::uniform_int_distribution< VkDeviceSize > size_distribution( 256, raw_size );
+    std::vector< VkMemoryRequirements > requirement_list( sub_count );
+    for( auto& ir: requirement_list )
+    {
+        ir = VkMemoryRequirements{ .size = size_distribution( engine ), .alignment = 256, .memoryTypeBits = ~0U };
+    }
+
+    std::vector< vkcpp::allocator::allocation > allocation_list;
+    allocation_list.reserve( sub_count );
+    auto const start = std::chrono::steady_clock::now();
+    for( auto const& ir: requirement_list )
+    {
+        allocation_list.push_back( allocator.allocate( ir, memory_flags ) );
+    }
+    auto const allocated = std::chrono::steady_clock::now();
+
+    auto const peak = allocator.stats();
+    // free every other allocation first to measure fragmentation before tearing everything down
+    auto const holing = std::chrono::steady_clock::now();
+    for( size_t ia = 0; ia < allocation_list.size(); ia += 2 )
+    {
+        allocation_list[ ia ].reset();
+    }
+    auto const holed_time = std::chrono::steady_clock::now();
+    auto const holed = allocator.stats();
+    auto const clearing = std::chrono::steady_clock::now();
+    allocation_list.clear();
+    auto const freed = std::chrono::steady_clock::now();
+
+    auto const per_allocation = []( auto const elapsed, size_t const count ) {
+        return static_cast< double >( std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() ) / static_cast< double >( count );
+    };
+    std::cout << "allocator::allocate: " << per_allocation( allocated - start, sub_count ) << " ns, allocation::reset: "
+              << per_allocation( ( holed_time - holing ) + ( freed - clearing ), sub_count ) << " ns" << std::endl;
+    std::cout << "    peak: " << peak.block_count << " blocks, " << peak.dedicated_count << " dedicated, " << peak.used_bytes << '/' << peak.reserved_bytes
+              << " bytes used" << std::endl;
+    std::cout << "    half freed: " << holed.free_bytes << " bytes free, fragmentation " << holed.fragmentation() << std::endl;
+}
+
+void bench_parallel_recording( vkcpp::device const& device )
+{
+    constexpr unsigned const frame_count = 50;
+    constexpr size_t const chunk_count = 64;
+    constexpr unsigned const commands_per_chunk = 2000;
+
+    auto const& dispatch = device.dispatch();
+    VkMemoryBarrier const barrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                   .pNext = nullptr,
+                                   .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                                   .dstAccessMask = VK_ACCESS_SHADER_READ_BIT };
+    // barriers need no resources, so the recording cost is purely the driver's command encoding
+    auto const record = [ & ]( vkcpp::command_buffer const& secondary, [[maybe_unused]] size_t const chunk ) {
+        for( unsigned ic = 0; ic < commands_per_chunk; ++ic )
+        {
+            dispatch.cmd_pipeline_barrier( secondary.native(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0,
+                                           nullptr, 0, nullptr );
+        }
+    };
+
+    double single_thread = 0.0;
+    auto const max_thread_count = std::max( std::thread::hardware_concurrency(), 1U );
+    for( unsigned it = 1; it <= max_thread_count; ++it )
+    {
+        vkcpp::command_pool_manager pools( device, 0 );
+        vkcpp::task_scheduler scheduler( it );
+        vkcpp::parallel_recorder recorder( pools, scheduler );
+
+        auto const frame = [ & ]() {
+            pools.begin_frame();
+            auto const primary = pools.allocate();
+            primary.begin();
+            recorder.record( primary, chunk_count, record );
+            primary.end();
+        };
+        // the first frames create the pools and buffers every later frame reuses
+        for( size_t iw = 0; iw < pools.frame_count(); ++iw )
+        {
+            frame();
+        }
+
+        auto const per_frame = nanoseconds_per_call( frame, frame_count ) / 1000000.0;
+        single_thread = 1 == it ? per_frame : single_thread;
+        std::cout << "parallel_recorder, " << it << " threads: " << per_frame << " ms per frame, speedup " << single_thread / per_frame << std::endl;
+    }
+}
+
+void bench_host_allocation( vkcpp::physical_device const physical_device )
+{
+    constexpr size_t const sizes[] = { 24, 64, 200, 1024 };
+    vkcpp::system_host_allocator system;
+    vkcpp::pool_host_allocator pool;
+    vkcpp::arena_host_allocator arena( pool );
+
+    auto const churn = [ & ]( vkcpp::host_allocator const& allocator, VkSystemAllocationScope const scope ) {
+        auto const* const callbacks = allocator.callbacks();
+        size_t ic = 0;
+        return nanoseconds_per_call( [ & ]() {
+            auto* const memory = callbacks->pfnAllocation( callbacks->pUserData, sizes[ ++ic % std::size( sizes ) ], 16, scope );
+            callbacks->pfnFree( callbacks->pUserData, memory );
+        } );
+    };
+    std::cout << "host allocation, command scope: system " << churn( system, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND ) << " ns, pool "
+              << churn( pool, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND ) << " ns, arena " << churn( arena, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND ) << " ns" << std::endl;
+    std::cout << "host allocation, object scope: system " << churn( system, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT ) << " ns, pool "
+              << churn( pool, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT ) << " ns" << std::endl;
+
+    // what the driver itself allocates while a device creates and destroys synchronisation objects
+    vkcpp::system_host_allocator counting;
+    {
+        auto device = vkcpp::device::builder().use_allocation_callbacks( counting.callbacks() ).build( physical_device, vkcpp::physical_device::feature(), {}, {} );
+        for( unsigned ii = 0; ii < 1000; ++ii )
+        {
+            vkcpp::fence<> fence( device );
+            vkcpp::semaphore<> semaphore( device );
+        }
+    }
+    char const* const scope_names[] = { "command", "object", "cache", "device", "instance" };
+    for( size_t is = 0; is < vkcpp::host_allocator::scope_count; ++is )
+    {
+        auto const stats = counting.stats( static_cast< vkcpp::host_allocator::scope >( is ) );
+        std::cout << "    driver " << scope_names[ is ] << " scope: " << stats.total_count << " allocations, peak " << stats.peak_bytes << " bytes" << std::endl;
+    }
+}
+
+void bench_handle_groups( vkcpp::device const& device )
+{
+    constexpr unsigned const group_count = 100000;
+    constexpr size_t const frame_count = 3;
+
+    // both include the driver's create and destroy, the difference is the heap allocation of the vector kind
+    std::cout << "fence group create+destroy: vector "
+              << nanoseconds_per_call( [ & ]() { static_cast< void >( vkcpp::fence< vkcpp::derived_handle_kind::vector >( device, frame_count ) ); }, group_count )
+              << " ns, array "
+              << nanoseconds_per_call( [ & ]() { static_cast< void >( vkcpp::fence< vkcpp::derived_handle_kind::array< frame_count > >( device ) ); }, group_count )
+              << " ns" << std::endl;
+}
+
+void bench_polling( vkcpp::device const& device )
+{
+    constexpr unsigned const poll_count = 100000;
+
+    // a fence nothing signals, so every zero timeout poll is a "not ready yet"
+    vkcpp::fence<> fence( device );
+    std::cout << "unsignaled fence poll: throwing "
+              << nanoseconds_per_call(
+                     [ & ]() {
+                         try
+                         {
+                             fence.wait( 0 );
+                         }
+                         catch( vkcpp::exception const& )
+                         {
+                         }
+                     },
+                     poll_count )
+              << " ns, expected " << nanoseconds_per_call( [ & ]() { static_cast< void >( fence.try_wait( 0 ) ); }, poll_count ) << " ns" << std::endl;
+}
+
+void bench_descriptor_allocation( vkcpp::device const& device )
+{
+    constexpr unsigned const frame_count = 100;
+    constexpr unsigned const sets_per_frame = 2000;
+
+    VkDescriptorSetLayoutBinding const binding{ 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr };
+    vkcpp::descriptor_set_layout const layout( device, VkDescriptorSetLayoutCreateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                                                                                        .pNext = nullptr,
+                                                                                        .flags = 0,
+                                                                                        .bindingCount = 1,
+                                                                                        .pBindings = &binding } );
+    // signaled from the start, so every retired frame is reset by the next pool the chains ask for
+    vkcpp::fence<> const done( device, 1, vkcpp::fence<>::create_flags( vkcpp::fence<>::create_flag::CREATE_SIGNALED ) );
+
+    auto const max_thread_count = std::max( std::thread::hardware_concurrency(), 1U );
+    for( unsigned it = 1; it <= max_thread_count; it *= 2 )
+    {
+        vkcpp::descriptor_allocator allocator( device );
+        auto const frame = [ & ]() {
+            std::vector< std::jthread > threads;
+            for( unsigned ithread = 0; ithread < it; ++ithread )
+            {
+                threads.emplace_back( [ & ]() {
+                    for( unsigned is = 0; is < sets_per_frame / it; ++is )
+                    {
+                        static_cast< void >( allocator.allocate( layout.native() ) );
+                    }
+                } );
+            }
+            threads.clear();
+            allocator.retire( done.native() );
+        };
+        // the first frames grow the chains to what a frame needs
+        frame();
+        frame();
+
+        auto const per_set = nanoseconds_per_call( frame, frame_count ) / sets_per_frame;
+        auto const stats = allocator.stats();
+        std::cout << "descriptor_allocator, " << it << " threads: " << per_set << " ns per set, " << stats.pool_count << " pools, " << stats.reset_count
+                  << " resets" << std::endl;
+    }
+}
+
+// submit to wake-up latencies in power of two microsecond buckets
+void print_latency_histogram( char const* const name, std::vector< std::chrono::nanoseconds >& latencies )
+{
+    std::sort( latencies.begin(), latencies.end() );
+    auto const percentile = [ & ]( size_t const pc ) { return latencies[ ( latencies.size() - 1 ) * pc / 100 ].count() / 1000.0; };
+    std::cout << name << ": p50 " << percentile( 50 ) << " us, p90 " << percentile( 90 ) << " us, p99 " << percentile( 99 ) << " us, max "
+              << percentile( 100 ) << " us" << std::endl;
+
+    std::array< size_t, 16 > buckets{};
+    for( auto const il: latencies )
+    {
+        auto const us = static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::microseconds >( il ).count() );
+        ++buckets[ std::min< size_t >( std::bit_width( us ), buckets.size() - 1 ) ];
+    }
+    for( size_t ib = 0; ib < buckets.size(); ++ib )
+    {
+        if( 0 < buckets[ ib ] )
+        {
+            std::cout << "    < " << ( uint64_t( 1 ) << ib ) << " us: " << std::string( ( buckets[ ib ] * 60 + latencies.size() - 1 ) / latencies.size(), '#' ) << ' '
+                      << buckets[ ib ] << std::endl;
+        }
+    }
+}
+
+void bench_fence_wait( vkcpp::device const& device )
+{
+    constexpr unsigned const wait_count = 2000;
+    constexpr unsigned const barrier_count = 200;
+
+    // a short job of a few tens of microseconds, the case where a kernel sleep costs more than the work
+    vkcpp::command_pool pool( device, 0 );
+    auto const buffer = pool.allocate( 1 ).front();
+    VkMemoryBarrier const barrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                   .pNext = nullptr,
+                                   .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                                   .dstAccessMask = VK_ACCESS_SHADER_READ_BIT };
+    buffer.begin( vkcpp::command_buffer::usage_flags() );
+    for( unsigned ib = 0; ib < barrier_count; ++ib )
+    {
+        device.dispatch().cmd_pipeline_barrier( buffer.native(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0,
+                                                nullptr, 0, nullptr );
+    }
+    buffer.end();
+
+    auto const native_buffer = buffer.native();
+    VkSubmitInfo const info{ .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO, .commandBufferCount = 1, .pCommandBuffers = &native_buffer };
+    vkcpp::device::queue queue( device, 0, 0 );
+    vkcpp::fence<> fence( device );
+
+    std::pair< char const*, vkcpp::wait_policy::mode > const modes[] = { { "fence wait, block", vkcpp::wait_policy::mode::BLOCK },
+                                                                           { "fence wait, spin then block", vkcpp::wait_policy::mode::SPIN_THEN_BLOCK },
+                                                                           { "fence wait, adaptive", vkcpp::wait_policy::mode::ADAPTIVE } };
+    for( auto const& [ name, mode ]: modes )
+    {
+        vkcpp::wait_policy policy( mode );
+        std::vector< std::chrono::nanoseconds > latencies;
+        latencies.reserve( wait_count );
+        for( unsigned iw = 0; iw < wait_count; ++iw )
+        {
+            auto const start = std::chrono::steady_clock::now();
+            queue.submit( std::span< VkSubmitInfo const >( &info, 1 ), fence.native() );
+            policy.wait( fence, std::numeric_limits< uint64_t >::max() );
+            latencies.push_back( std::chrono::steady_clock::now() - start );
+            fence.reset_signal();
+        }
+        print_latency_histogram( name, latencies );
+    }
+}
+
+} // namespace
+
+int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
+{
+    try
+    {
+        vkcpp::instance instance( "vkcpp-bench", vkcpp::version( 0, 0, 1 ), "vkcpp-engine", vkcpp::version( 0, 0, 1 ), {}, { vkcpp::extension::debug_report } );
+
+        bench_debug_lookup( instance );
+        bench_report_sink();
+
+        auto devlist = vkcpp::physical_device::enumerate( instance );
+        if( devlist.empty() )
+        {
+            std::cout << "no physical device" << std::endl;
+            return 1;
+        }
+
+        auto physical_device = pick_device( devlist );
+        std::cout << "Device: " << vkcpp::physical_device::property( physical_device ).name() << std::endl;
+
+        auto device = vkcpp::device::builder().reserve_queue_family( 0, { 1.0F } ).build( physical_device, vkcpp::physical_device::feature(), {}, {} );
+
+        bench_dispatch( device );
+        bench_allocator( device, physical_device );
+        bench_parallel_recording( device );
+        bench_host_allocation( physical_device );
+        bench_handle_groups( device );
+        bench_polling( device );
+        bench_fence_wait( device );
+        bench_descriptor_allocation( device );
+        return 0;
+    }
+    catch( vkcpp::exception& ex )
+    {
+        std::cout << "Vulkan Exception: " << std::hex << ( unsigned )ex.object << ',' << ( unsigned )ex.result << ':' << ex.what() << std::endl;
+    }
+    catch( std::exception& ex )
+    {
+        std::cout << "Standard Exception: " << ex.what() << std::endl;
+    }
+    return 1;
+}
@@ -0,0 +1,149 @@
+#undef NDEBUG
+#include <vkcpp/descriptor.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+using namespace vkcpp;
+
+struct single_set
+{
+    binding::storage_buffer< 3 > data;
+};
+
+// members of different sizes and alignments, out of binding order
+struct mixed_set
+{
+    binding::uniform_buffer< 2 > constants;
+    binding::combined_image_sampler< 0, 4 > textures;
+    binding::descriptor< 5, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER > texels;
+    binding::storage_image< 1 > target;
+    binding::descriptor< 7, VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 3 > more_texels;
+};
+
+// the largest struct the derivation takes
+struct full_set
+{
+    binding::storage_buffer< 0 > b0;
+    binding::storage_buffer< 1 > b1;
+    binding::storage_buffer< 2 > b2;
+    binding::storage_buffer< 3 > b3;
+    binding::storage_buffer< 4 > b4;
+    binding::storage_buffer< 5 > b5;
+    binding::storage_buffer< 6 > b6;
+    binding::storage_buffer< 7 > b7;
+    binding::sampled_image< 8 > b8;
+    binding::sampled_image< 9 > b9;
+    binding::sampled_image< 10 > b10;
+    binding::sampled_image< 11 > b11;
+    binding::sampled_image< 12 > b12;
+    binding::sampled_image< 13 > b13;
+    binding::sampled_image< 14 > b14;
+    binding::sampled_image< 15, 2 > b15;
+};
+
+static_assert( std::is_same_v< private_::set_fields< single_set >, private_::type_list< binding::storage_buffer< 3 > > > );
+static_assert( std::is_same_v< private_::set_fields< mixed_set >,
+                               private_::type_list< binding::uniform_buffer< 2 >, binding::combined_image_sampler< 0, 4 >,
+                                                    binding::descriptor< 5, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER >, binding::storage_image< 1 >,
+                                                    binding::descriptor< 7, VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 3 > > > );
+static_assert( 16 == private_::set_fields< full_set >::size );
+
+static_assert( std::is_same_v< binding::uniform_buffer< 0 >::value_type, VkDescriptorBufferInfo > );
+static_assert( std::is_same_v< binding::descriptor< 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC >::value_type, VkDescriptorBufferInfo > );
+static_assert( std::is_same_v< binding::descriptor< 0, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER >::value_type, VkBufferView > );
+static_assert( std::is_same_v< binding::sampled_image< 0 >::value_type, VkDescriptorImageInfo > );
+
+// each entry has to point at its member where the compiler put it
+template< typename set_type, size_t entry_count >
+void check_entries( std::array< size_t, entry_count > const& offsets )
+{
+    using set_template = descriptor_set_template< set_type >;
+    static_assert( entry_count == set_template::fields::size );
+    static_assert( entry_count == set_template::entries.size() );
+    for( size_t ie = 0; ie < entry_count; ++ie )
+    {
+        assert( offsets[ ie ] == set_template::entries[ ie ].offset );
+        assert( 0 == set_template::entries[ ie ].dstArrayElement );
+    }
+    assert( offsets.back() + set_template::entries.back().stride * set_template::entries.back().descriptorCount <= sizeof( set_type ) );
+
+    auto const bindings = set_template::layout_bindings( VK_SHADER_STAGE_COMPUTE_BIT );
+    for( size_t ie = 0; ie < entry_count; ++ie )
+    {
+        assert( set_template::entries[ ie ].dstBinding == bindings[ ie ].binding );
+        assert( set_template::entries[ ie ].descriptorType == bindings[ ie ].descriptorType );
+        assert( set_template::entries[ ie ].descriptorCount == bindings[ ie ].descriptorCount );
+        assert( VK_SHADER_STAGE_COMPUTE_BIT == bindings[ ie ].stageFlags );
+        assert( nullptr == bindings[ ie ].pImmutableSamplers );
+    }
+}
+
+void test_single()
+{
+    check_entries< single_set, 1 >( { offsetof( single_set, data ) } );
+    auto const& entry = descriptor_set_template< single_set >::entries[ 0 ];
+    assert( 3 == entry.dstBinding );
+    assert( VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == entry.descriptorType );
+    assert( 1 == entry.descriptorCount );
+    assert( sizeof( VkDescriptorBufferInfo ) == entry.stride );
+}
+
+void test_mixed()
+{
+    check_entries< mixed_set, 5 >( { offsetof( mixed_set, constants ), offsetof( mixed_set, textures ), offsetof( mixed_set, texels ),
+                                     offsetof( mixed_set, target ), offsetof( mixed_set, more_texels ) } );
+
+    // entries keep the member order, not the binding order
+    auto const& entries = descriptor_set_template< mixed_set >::entries;
+    uint32_t const bindings[] = { 2, 0, 5, 1, 7 };
+    VkDescriptorType const types[] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+                                       VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER };
+    uint32_t const counts[] = { 1, 4, 1, 1, 3 };
+    size_t const strides[] = { sizeof( VkDescriptorBufferInfo ), sizeof( VkDescriptorImageInfo ), sizeof( VkBufferView ), sizeof( VkDescriptorImageInfo ),
+                               sizeof( VkBufferView ) };
+    for( size_t ie = 0; ie < entries.size(); ++ie )
+    {
+        assert( bindings[ ie ] == entries[ ie ].dstBinding );
+        assert( types[ ie ] == entries[ ie ].descriptorType );
+        assert( counts[ ie ] == entries[ ie ].descriptorCount );
+        assert( strides[ ie ] == entries[ ie ].stride );
+    }
+
+    // an array binding's elements sit a stride apart, where the template reads them
+    mixed_set data{};
+    data.textures[ 2 ].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    auto const& entry = entries[ 1 ];
+    auto const* const element = reinterpret_cast< VkDescriptorImageInfo const* >( reinterpret_cast< char const* >( &data ) + entry.offset + 2 * entry.stride );
+    assert( VK_IMAGE_LAYOUT_GENERAL == element->imageLayout );
+}
+
+void test_full()
+{
+    check_entries< full_set, 16 >( { offsetof( full_set, b0 ), offsetof( full_set, b1 ), offsetof( full_set, b2 ), offsetof( full_set, b3 ),
+                                     offsetof( full_set, b4 ), offsetof( full_set, b5 ), offsetof( full_set, b6 ), offsetof( full_set, b7 ),
+                                     offsetof( full_set, b8 ), offsetof( full_set, b9 ), offsetof( full_set, b10 ), offsetof( full_set, b11 ),
+                                     offsetof( full_set, b12 ), offsetof( full_set, b13 ), offsetof( full_set, b14 ), offsetof( full_set, b15 ) } );
+    auto const& entries = descriptor_set_template< full_set >::entries;
+    for( uint32_t ie = 0; ie < entries.size(); ++ie )
+    {
+        assert( ie == entries[ ie ].dstBinding );
+        assert( ( 8 > ie ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ) == entries[ ie ].descriptorType );
+    }
+    assert( 2 == entries.back().descriptorCount );
+}
+
+} // namespace
+
+int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
+{
+    test_single();
+    test_mixed();
+    test_full();
+    std::cout << "descriptor_set_template: passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,185 @@
+#undef NDEBUG
+#include <vkcpp/hash.hpp>
+#include <vkcpp/pipeline.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using vkcpp::private_::content_key;
+
+// a handle value that was never created, the keys must not look at it anyway
+template< typename handle_type >
+handle_type fake_handle( uint64_t const value )
+{
+    static_assert( sizeof( handle_type ) == sizeof( value ) );
+    handle_type result;
+    std::memcpy( &result, &value, sizeof( result ) );
+    return result;
+}
+
+struct colliding_hash
+{
+    size_t operator()( std::string const& ) const noexcept { return 0; }
+};
+
+void test_stability()
+{
+    auto const build = []()
+    {
+        content_key key;
+        std::vector< uint32_t > const words{ 1, 2, 3 };
+        key.add( uint32_t( 7 ) ).add( 2.5F ).add( std::string_view( "main" ) ).add( std::span< uint32_t const >( words ) );
+        return key;
+    };
+    auto const first = build();
+    auto const second = build();
+    assert( first.bytes() == second.bytes() );
+    assert( first.hash() == second.hash() );
+    assert( !first.bytes().empty() );
+
+    auto copy = first;
+    assert( first.bytes() == std::move( copy ).bytes() );
+}
+
+void test_boundaries()
+{
+    // the length prefixes keep neighbouring strings and ranges from trading content
+    assert( content_key().add( std::string_view( "ab" ) ).add( std::string_view( "c" ) ).bytes()
+            != content_key().add( std::string_view( "a" ) ).add( std::string_view( "bc" ) ).bytes() );
+    assert( content_key().add( std::string_view( "" ) ).add( std::string_view( "x" ) ).bytes()
+            != content_key().add( std::string_view( "x" ) ).add( std::string_view( "" ) ).bytes() );
+
+    std::vector< uint32_t > const one{ 1 };
+    std::vector< uint32_t > const two{ 1, 2 };
+    std::vector< uint32_t > const none;
+    std::vector< uint32_t > const second{ 2 };
+    assert( content_key().add( std::span< uint32_t const >( two ) ).add( std::span< uint32_t const >( none ) ).bytes()
+            != content_key().add( std::span< uint32_t const >( one ) ).add( std::span< uint32_t const >( second ) ).bytes() );
+
+    // the same bytes as differently typed values are still the same content
+    assert( content_key().add( uint64_t( 0 ) ).bytes() == content_key().add( uint32_t( 0 ) ).add( uint32_t( 0 ) ).bytes() );
+}
+
+vkcpp::compute_pipeline_description compute( std::string module_key, std::string layout_key )
+{
+    // a handle always comes with the key of its content
+    vkcpp::compute_pipeline_description description;
+    description.stage.module = module_key.empty() ? VK_NULL_HANDLE : fake_handle< VkShaderModule >( 0x10 );
+    description.stage.module_key = std::move( module_key );
+    description.layout = layout_key.empty() ? VK_NULL_HANDLE : fake_handle< VkPipelineLayout >( 0x20 );
+    description.layout_key = std::move( layout_key );
+    return description;
+}
+
+void test_descriptions()
+{
+    auto const base = compute( "module a", "layout a" ).key();
+    assert( base.bytes() == compute( "module a", "layout a" ).key().bytes() );
+
+    // a handle the driver hands out again for other content must not find the old pipeline, and the same content
+    // behind another handle must
+    auto moved = compute( "module a", "layout a" );
+    moved.stage.module = fake_handle< VkShaderModule >( 0x11 );
+    moved.layout = fake_handle< VkPipelineLayout >( 0x21 );
+    assert( base.bytes() == moved.key().bytes() );
+    assert( base.bytes() != compute( "module b", "layout a" ).key().bytes() );
+    assert( base.bytes() != compute( "module a", "layout b" ).key().bytes() );
+    // the module and layout keys are delimited, so shifting text between them is a different pipeline
+    assert( compute( "ab", "c" ).key().bytes() != compute( "a", "bc" ).key().bytes() );
+
+    auto entry = compute( "module a", "layout a" );
+    entry.stage.entry_point = "other";
+    assert( base.bytes() != entry.key().bytes() );
+
+    auto specialized = compute( "module a", "layout a" );
+    specialized.stage.specialization_entries.push_back( VkSpecializationMapEntry{ .constantID = 0, .offset = 0, .size = 4 } );
+    specialized.stage.specialization_data.resize( 4, std::byte( 1 ) );
+    auto const specialized_key = specialized.key();
+    assert( base.bytes() != specialized_key.bytes() );
+    specialized.stage.specialization_data[ 0 ] = std::byte( 2 );
+    assert( specialized_key.bytes() != specialized.key().bytes() );
+
+    vkcpp::graphics_pipeline_description graphics;
+    graphics.stages.push_back( compute( "vertex", "" ).stage );
+    graphics.stages.back().stage = VK_SHADER_STAGE_VERTEX_BIT;
+    graphics.layout = fake_handle< VkPipelineLayout >( 0x20 );
+    graphics.layout_key = "layout a";
+    auto const graphics_key = graphics.key();
+    assert( graphics_key.bytes() == vkcpp::graphics_pipeline_description( graphics ).key().bytes() );
+
+    auto culled = graphics;
+    culled.rasterization.cullMode = VK_CULL_MODE_BACK_BIT;
+    assert( graphics_key.bytes() != culled.key().bytes() );
+
+    auto viewport = graphics;
+    viewport.viewports.push_back( VkViewport{ .x = 0, .y = 0, .width = 64, .height = 64, .minDepth = 0, .maxDepth = 1 } );
+    auto const viewport_key = viewport.key();
+    assert( graphics_key.bytes() != viewport_key.bytes() );
+    viewport.viewports.back().width = 128;
+    assert( viewport_key.bytes() != viewport.key().bytes() );
+
+    auto rendered = graphics;
+    rendered.render_pass = fake_handle< VkRenderPass >( 0x30 );
+    rendered.render_pass_key = "render pass a";
+    rendered.subpass = 1;
+    auto const rendered_key = rendered.key();
+    assert( graphics_key.bytes() != rendered_key.bytes() );
+
+    // the render pass handle reused for another render pass
+    auto reused = rendered;
+    reused.render_pass_key = "render pass b";
+    assert( rendered_key.bytes() != reused.key().bytes() );
+    reused.render_pass = fake_handle< VkRenderPass >( 0x31 );
+    reused.render_pass_key = rendered.render_pass_key;
+    assert( rendered_key.bytes() == reused.key().bytes() );
+}
+
+void test_collisions()
+{
+    // variants that differ in one field each never share a key
+    std::vector< std::string > keys;
+    for( unsigned im = 0; im < 8; ++im )
+    {
+        for( unsigned il = 0; il < 8; ++il )
+        {
+            for( VkPipelineCreateFlags const flags: { VkPipelineCreateFlags( 0 ), VkPipelineCreateFlags( VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT ) } )
+            {
+                auto description = compute( "module " + std::to_string( im ), std::string( il, 'l' ) );
+                description.flags = flags;
+                keys.push_back( description.key().bytes() );
+            }
+        }
+    }
+    assert( keys.size() == std::set< std::string >( keys.begin(), keys.end() ).size() );
+
+    // the bytes are the comparison, so even with every hash colliding a lookup finds its own entry
+    std::unordered_map< std::string, size_t, colliding_hash > entries;
+    for( size_t ik = 0; ik < keys.size(); ++ik )
+    {
+        assert( entries.emplace( keys[ ik ], ik ).second );
+    }
+    for( size_t ik = 0; ik < keys.size(); ++ik )
+    {
+        assert( ik == entries.at( keys[ ik ] ) );
+    }
+}
+
+} // namespace
+
+int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
+{
+    test_stability();
+    test_boundaries();
+    test_descriptions();
+    test_collisions();
+    std::cout << "content_key: passed" << std::endl;
+    return 0;
+}
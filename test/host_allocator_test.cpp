@@ -0,0 +1,168 @@
+#undef NDEBUG
+#include <vkcpp/host_allocator.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// the driver's side of the callbacks
+struct driver
+{
+    VkAllocationCallbacks const* pcallbacks;
+
+    void* allocate( size_t const size, size_t const alignment, VkSystemAllocationScope const scope ) const
+    {
+        return pcallbacks->pfnAllocation( pcallbacks->pUserData, size, alignment, scope );
+    }
+
+    void* reallocate( void* const original, size_t const size, size_t const alignment, VkSystemAllocationScope const scope ) const
+    {
+        return pcallbacks->pfnReallocation( pcallbacks->pUserData, original, size, alignment, scope );
+    }
+
+    void free( void* const memory ) const { pcallbacks->pfnFree( pcallbacks->pUserData, memory ); }
+};
+
+bool aligned( void const* const memory, size_t const alignment ) { return 0 == reinterpret_cast< uintptr_t >( memory ) % alignment; }
+
+// every size and alignment the driver may ask for, below and above the pool's largest class
+void check_alignment( vkcpp::host_allocator& allocator, VkSystemAllocationScope const scope )
+{
+    driver const callbacks{ allocator.callbacks() };
+    std::vector< void* > blocks;
+    for( size_t alignment = 1; alignment <= 4096; alignment *= 2 )
+    {
+        for( size_t const size: { size_t( 1 ), size_t( 24 ), size_t( 100 ), size_t( 4096 ), size_t( 10000 ) } )
+        {
+            auto* const memory = callbacks.allocate( size, alignment, scope );
+            assert( nullptr != memory );
+            assert( aligned( memory, alignment ) );
+            std::memset( memory, 0xA5, size );
+            blocks.push_back( memory );
+        }
+    }
+    assert( blocks.size() == allocator.stats( static_cast< vkcpp::host_allocator::scope >( scope ) ).count );
+    for( auto* const ib: blocks )
+    {
+        callbacks.free( ib );
+    }
+    assert( 0 == allocator.stats().count );
+    assert( 0 == allocator.stats().bytes );
+}
+
+void check_reallocation( vkcpp::host_allocator& allocator, VkSystemAllocationScope const scope )
+{
+    driver const callbacks{ allocator.callbacks() };
+    auto* memory = static_cast< unsigned char* >( callbacks.allocate( 64, 16, scope ) );
+    for( unsigned ib = 0; ib < 64; ++ib )
+    {
+        memory[ ib ] = static_cast< unsigned char >( ib );
+    }
+    memory = static_cast< unsigned char* >( callbacks.reallocate( memory, 1000, 256, scope ) );
+    assert( aligned( memory, 256 ) );
+    for( unsigned ib = 0; ib < 64; ++ib )
+    {
+        assert( ib == memory[ ib ] );
+    }
+    assert( 1000 == allocator.stats().bytes );
+    assert( nullptr == callbacks.reallocate( memory, 0, 16, scope ) );
+    assert( 0 == allocator.stats().count );
+    assert( nullptr == callbacks.allocate( 0, 16, scope ) );
+    callbacks.free( nullptr );
+}
+
+void test_pool()
+{
+    vkcpp::pool_host_allocator allocator;
+    check_alignment( allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+    check_reallocation( allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+
+    // a freed block is the next one handed out of its class
+    driver const callbacks{ allocator.callbacks() };
+    auto* const first = callbacks.allocate( 100, 8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+    auto* const second = callbacks.allocate( 100, 8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+    assert( first != second );
+    callbacks.free( first );
+    auto* const reused = callbacks.allocate( 90, 8, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE );
+    assert( first == reused );
+    callbacks.free( second );
+    callbacks.free( reused );
+
+    auto const totals = allocator.stats();
+    assert( 0 == totals.count && 0 == totals.bytes );
+    assert( 200 <= totals.peak_bytes );
+
+    // blocks handed back from other threads land on the shared free lists
+    std::vector< void* > blocks( 1000 );
+    for( auto& ib: blocks )
+    {
+        ib = callbacks.allocate( 48, 16, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+    }
+    std::jthread( [ & ]() {
+        for( auto* const ib: blocks )
+        {
+            callbacks.free( ib );
+        }
+    } ).join();
+    for( auto& ib: blocks )
+    {
+        ib = callbacks.allocate( 48, 16, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+        assert( aligned( ib, 16 ) );
+    }
+    for( auto* const ib: blocks )
+    {
+        callbacks.free( ib );
+    }
+    assert( 0 == allocator.stats().count );
+}
+
+void test_arena()
+{
+    vkcpp::system_host_allocator fallback;
+    vkcpp::arena_host_allocator allocator( fallback );
+    check_alignment( allocator, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+    check_alignment( allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT );
+    check_reallocation( allocator, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+
+    // once everything in the chunk was freed the next command allocation starts at its beginning again
+    driver const callbacks{ allocator.callbacks() };
+    auto* const first = callbacks.allocate( 100, 16, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+    auto* const second = callbacks.allocate( 200, 64, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+    assert( aligned( second, 64 ) );
+    assert( static_cast< char* >( first ) + 100 <= static_cast< char* >( second ) );
+    callbacks.free( first );
+    // still one allocation alive, no rewind
+    auto* const third = callbacks.allocate( 100, 16, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+    assert( first != third );
+    callbacks.free( second );
+    callbacks.free( third );
+    auto* const rewound = callbacks.allocate( 100, 16, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND );
+    assert( first == rewound );
+    callbacks.free( rewound );
+
+    // allocations from a chunk outlive the thread that made them
+    void* memory = nullptr;
+    std::jthread( [ & ]() { memory = callbacks.allocate( 256, 16, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND ); } ).join();
+    std::memset( memory, 0x5A, 256 );
+    callbacks.free( memory );
+
+    assert( 0 == allocator.stats().count );
+    assert( 0 == allocator.stats().bytes );
+    assert( 0 < allocator.stats( vkcpp::host_allocator::scope::COMMAND ).total_count );
+    assert( 0 < allocator.stats( vkcpp::host_allocator::scope::OBJECT ).total_count );
+}
+
+} // namespace
+
+int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
+{
+    test_pool();
+    test_arena();
+    std::cout << "host_allocator: passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,146 @@
+#undef NDEBUG
+#include <vkcpp/ring.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using vkcpp::private_::mpsc_ring;
+
+void test_capacity()
+{
+    assert( 2 == mpsc_ring< int >( 0 ).capacity() );
+    assert( 2 == mpsc_ring< int >( 1 ).capacity() );
+    assert( 8 == mpsc_ring< int >( 8 ).capacity() );
+    assert( 16 == mpsc_ring< int >( 9 ).capacity() );
+}
+
+void test_full_ring()
+{
+    mpsc_ring< int > ring( 4 );
+    assert( ring.empty() );
+    for( int iv = 0; iv < 4; ++iv )
+    {
+        assert( ring.try_push( [ & ]( int& slot ) noexcept { slot = iv; } ) );
+    }
+
+    // a full ring refuses the push without calling fill
+    bool filled = false;
+    assert( !ring.try_push( [ & ]( int& ) noexcept { filled = true; } ) );
+    assert( !filled );
+
+    // one pop frees exactly one slot
+    int value = -1;
+    assert( ring.try_pop( [ & ]( int& slot ) { value = slot; } ) );
+    assert( 0 == value );
+    assert( ring.try_push( [ & ]( int& slot ) noexcept { slot = 4; } ) );
+    assert( !ring.try_push( []( int& ) noexcept {} ) );
+
+    for( int expected = 1; expected <= 4; ++expected )
+    {
+        assert( ring.try_pop( [ & ]( int& slot ) { value = slot; } ) );
+        assert( expected == value );
+    }
+    assert( ring.empty() );
+    assert( !ring.try_pop( []( int& ) { assert( false ); } ) );
+}
+
+void test_wraparound()
+{
+    // many laps over a small ring with the fill level shifting, values come out in order
+    mpsc_ring< std::string > ring( 4 );
+    int pushed = 0;
+    int popped = 0;
+    for( int lap = 0; lap < 1000; ++lap )
+    {
+        for( int ip = 0; ip < 1 + lap % 4; ++ip )
+        {
+            auto text = std::to_string( pushed );
+            if( ring.try_push( [ & ]( std::string& slot ) noexcept { slot.swap( text ); } ) )
+            {
+                ++pushed;
+            }
+        }
+        for( int ip = 0; ip < 1 + ( lap + 1 ) % 3; ++ip )
+        {
+            std::string value;
+            if( ring.try_pop( [ & ]( std::string& slot ) { value.swap( slot ); } ) )
+            {
+                assert( std::to_string( popped ) == value );
+                ++popped;
+            }
+        }
+    }
+    while( ring.try_pop( [ & ]( std::string& slot ) { assert( std::to_string( popped ) == slot ); } ) )
+    {
+        ++popped;
+    }
+    assert( pushed == popped );
+    assert( 1000 < popped );
+    assert( ring.empty() );
+}
+
+void test_producers()
+{
+    // each producer's values arrive in the order it pushed them and none is lost or doubled
+    constexpr unsigned const producer_count = 4;
+    constexpr uint32_t const per_producer = 100000;
+
+    mpsc_ring< uint64_t > ring( 64 );
+    std::vector< std::jthread > producers;
+    for( unsigned ip = 0; ip < producer_count; ++ip )
+    {
+        producers.emplace_back(
+            [ &ring, ip ]()
+            {
+                for( uint32_t iv = 0; iv < per_producer; ++iv )
+                {
+                    auto const value = ( uint64_t( ip ) << 32U ) | iv;
+                    while( !ring.try_push( [ value ]( uint64_t& slot ) noexcept { slot = value; } ) )
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            } );
+    }
+
+    std::vector< uint32_t > next( producer_count, 0 );
+    for( uint64_t received = 0; received < uint64_t( producer_count ) * per_producer; )
+    {
+        if( !ring.try_pop(
+                [ & ]( uint64_t const& slot )
+                {
+                    auto const producer = static_cast< size_t >( slot >> 32U );
+                    assert( producer < producer_count );
+                    assert( next[ producer ] == static_cast< uint32_t >( slot ) );
+                    ++next[ producer ];
+                } ) )
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ++received;
+    }
+    for( auto const in: next )
+    {
+        assert( per_producer == in );
+    }
+    assert( ring.empty() );
+}
+
+} // namespace
+
+int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
+{
+    test_capacity();
+    test_full_ring();
+    test_wraparound();
+    test_producers();
+    std::cout << "mpsc_ring: passed" << std::endl;
+    return 0;
+}
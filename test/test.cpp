@@ -31,6 +31,18 @@ int main( [[maybe_unused]] int argc, [[maybe_unused]] char* argv[] )
 
             auto devext_list = vkcpp::device_extension::enumerate( id, nullptr );
             for( auto const& ie : devext_list )  { std::cout << "    Extension: " << ie.name() << ',' << ie.spec_version() << std::endl; }
+
+            vkcpp::device::queue::topology topology( id );
+            char const* const kind_names[] = { "graphics", "computation", "transfer", "sparse binding" };
+            for( unsigned ik = 0; ik < std::size( kind_names ); ++ik )
+            {
+                auto const queue_kind = static_cast< vkcpp::device::queue::kind >( ik );
+                if( topology.has( queue_kind ) )
+                {
+                    std::cout << "    Queue: " << kind_names[ ik ] << " on family " << topology[ queue_kind ].family_index << ", queue " << topology[ queue_kind ].index
+                              << ( topology.dedicated( queue_kind ) ? ", dedicated" : "" ) << std::endl;
+                }
+            }
         
         }
 